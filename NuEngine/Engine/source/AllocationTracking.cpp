@@ -0,0 +1,176 @@
+#include "NuEngine/AllocationTracking.h"
+
+#include <atomic>
+
+#if NU_ENABLE_ALLOCATION_TRACKING
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#endif
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// Phase set by the frame loop, used by every thread that didn't set its own
+		std::atomic<FramePhase> g_framePhase = FramePhase::Other;
+
+		// Phase set by the calling thread; Other if it follows the frame loop
+		thread_local FramePhase t_framePhase = FramePhase::Other;
+
+		struct PhaseCounters
+		{
+			std::atomic<uint64_t> allocations = 0;
+			std::atomic<uint64_t> bytes = 0;
+		};
+
+		std::array<PhaseCounters, framePhaseCount> g_phaseCounters;
+		std::atomic<uint64_t> g_liveBytes = 0;
+		std::atomic<uint64_t> g_peakLiveBytes = 0;
+
+		[[maybe_unused]] void RecordAllocation(size_t bytes) noexcept
+		{
+			const auto phase = t_framePhase != FramePhase::Other ? t_framePhase : g_framePhase.load(std::memory_order_relaxed);
+			auto& counters = g_phaseCounters[static_cast<size_t>(phase)];
+			counters.allocations.fetch_add(1, std::memory_order_relaxed);
+			counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+			const uint64_t liveBytes = g_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			uint64_t peakLiveBytes = g_peakLiveBytes.load(std::memory_order_relaxed);
+			while (liveBytes > peakLiveBytes && !g_peakLiveBytes.compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		[[maybe_unused]] void RecordDeallocation(size_t bytes) noexcept
+		{
+			g_liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+		}
+	} // namespace
+
+	namespace allocations
+	{
+		void SetFramePhase(FramePhase phase) noexcept
+		{
+			g_framePhase.store(phase, std::memory_order_relaxed);
+		}
+
+		void SetThreadFramePhase(FramePhase phase) noexcept
+		{
+			t_framePhase = phase;
+		}
+
+		AllocationSnapshot GetSnapshot() noexcept
+		{
+			AllocationSnapshot snapshot;
+			for (size_t i = 0; i < framePhaseCount; ++i)
+			{
+				snapshot.phases[i].allocations = g_phaseCounters[i].allocations.load(std::memory_order_relaxed);
+				snapshot.phases[i].bytes = g_phaseCounters[i].bytes.load(std::memory_order_relaxed);
+			}
+			snapshot.liveBytes = g_liveBytes.load(std::memory_order_relaxed);
+			snapshot.peakLiveBytes = g_peakLiveBytes.load(std::memory_order_relaxed);
+			return snapshot;
+		}
+	} // namespace allocations
+} // namespace engine
+} // namespace nu
+
+#if NU_ENABLE_ALLOCATION_TRACKING
+// Replacements for the global allocation functions. The nothrow forms call these by default; the array and sized forms
+// are replaced too, as some runtimes don't forward them. Sizes are read back from the CRT heap on delete, so blocks don't
+// need a header.
+void* operator new(size_t size)
+{
+	void* pointer;
+	while ((pointer = std::malloc(size > 0 ? size : 1)) == nullptr)
+	{
+		auto newHandler = std::get_new_handler();
+		if (newHandler == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		newHandler();
+	}
+
+	nu::engine::RecordAllocation(_msize(pointer));
+	return pointer;
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* pointer;
+	while ((pointer = _aligned_malloc(size > 0 ? size : 1, static_cast<size_t>(alignment))) == nullptr)
+	{
+		auto newHandler = std::get_new_handler();
+		if (newHandler == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		newHandler();
+	}
+
+	nu::engine::RecordAllocation(_aligned_msize(pointer, static_cast<size_t>(alignment), 0));
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (pointer != nullptr)
+	{
+		nu::engine::RecordDeallocation(_msize(pointer));
+		std::free(pointer);
+	}
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+	if (pointer != nullptr)
+	{
+		nu::engine::RecordDeallocation(_aligned_msize(pointer, static_cast<size_t>(alignment), 0));
+		_aligned_free(pointer);
+	}
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept
+{
+	operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+	operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(pointer, alignment);
+}
+#endif
@@ -0,0 +1,96 @@
+#include "NuEngine/Clock.h"
+
+#include <array>
+#include <thread>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// How long the TSC is counted against the steady clock; long enough that the error of the reads is negligible
+		constexpr auto calibrationTime = 20ms;
+
+		struct TscCalibration
+		{
+			bool isAvailable = false;
+			double ticksPerSecond = 0.0;
+		};
+
+		bool IsTscInvariant()
+		{
+#if NU_HAS_TSC
+			// CPUID leaf 0x80000007 reports an invariant TSC in bit 8 of EDX
+			std::array<int, 4> registers{};
+			__cpuid(registers.data(), 0x80000000);
+			if (static_cast<uint32_t>(registers[0]) < 0x80000007)
+			{
+				return false;
+			}
+
+			__cpuid(registers.data(), 0x80000007);
+			return (registers[3] & (1 << 8)) != 0;
+#else
+			return false;
+#endif
+		}
+
+		TscCalibration CalibrateTsc()
+		{
+			TscCalibration calibration;
+			if (!IsTscInvariant())
+			{
+				return calibration;
+			}
+
+			// Bracket each steady clock read with TSC reads and use their midpoint, so a preemption between the reads
+			// only skews the result by half its length
+			auto sample = []()
+			{
+				const int64_t tscBefore = clock::Now(ClockSource::Tsc);
+				const auto steadyTime = std::chrono::steady_clock::now();
+				const int64_t tscAfter = clock::Now(ClockSource::Tsc);
+				return std::pair{ tscBefore + (tscAfter - tscBefore) / 2, steadyTime };
+			};
+
+			const auto [tscStart, steadyStart] = sample();
+			std::this_thread::sleep_for(calibrationTime);
+			const auto [tscEnd, steadyEnd] = sample();
+
+			const double seconds = std::chrono::duration<double>(steadyEnd - steadyStart).count();
+			calibration.ticksPerSecond = static_cast<double>(tscEnd - tscStart) / seconds;
+			calibration.isAvailable = calibration.ticksPerSecond > 0.0;
+			return calibration;
+		}
+
+		const TscCalibration& GetTscCalibration()
+		{
+			static const TscCalibration calibration = CalibrateTsc();
+			return calibration;
+		}
+	} // namespace
+
+	namespace clock
+	{
+		bool IsTscAvailable()
+		{
+			return GetTscCalibration().isAvailable;
+		}
+
+		double GetTicksPerSecond(ClockSource source)
+		{
+			if (source == ClockSource::Tsc && IsTscAvailable())
+			{
+				return GetTscCalibration().ticksPerSecond;
+			}
+
+			using Period = std::chrono::steady_clock::period;
+			return static_cast<double>(Period::den) / static_cast<double>(Period::num);
+		}
+	} // namespace clock
+} // namespace engine
+} // namespace nu
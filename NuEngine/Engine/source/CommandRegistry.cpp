@@ -0,0 +1,169 @@
+#include "NuEngine/CommandRegistry.h"
+
+#include <algorithm>
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// Splits a line into words separated by spaces
+		std::vector<std::u8string_view> SplitWords(std::u8string_view line)
+		{
+			std::vector<std::u8string_view> words;
+			size_t position = 0;
+			while (position < line.size())
+			{
+				const size_t start = line.find_first_not_of(u8' ', position);
+				if (start == std::u8string_view::npos)
+				{
+					break;
+				}
+
+				const size_t end = std::min(line.find(u8' ', start), line.size());
+				words.emplace_back(line.substr(start, end - start));
+				position = end;
+			}
+			return words;
+		}
+	} // namespace
+
+	void CommandRegistry::RegisterCommand(std::u8string_view name, std::u8string_view description, CommandHandler handler)
+	{
+		Entry entry;
+		entry.description = description;
+		entry.command = std::move(handler);
+		AddEntry(name, std::move(entry));
+	}
+
+	void CommandRegistry::Unregister(std::u8string_view name)
+	{
+		if (auto it = m_entries.find(name); it != m_entries.end())
+		{
+			m_entries.erase(it);
+		}
+	}
+
+	bool CommandRegistry::Execute(std::u8string_view line, std::u8string& output) const
+	{
+		const auto words = SplitWords(line);
+		if (words.empty())
+		{
+			return false;
+		}
+
+		auto it = m_entries.find(words.front());
+		if (it == m_entries.end())
+		{
+			return false;
+		}
+
+		const auto& [name, entry] = *it;
+		const auto args = std::span(words).subspan(1);
+		if (entry.command)
+		{
+			output = entry.command(args);
+			return true;
+		}
+
+		if (args.empty())
+		{
+			output = name + u8" = " + entry.getValue();
+			return true;
+		}
+
+		if (!entry.setValue(args.front()))
+		{
+			output = u8"Invalid value for " + name + u8": " + std::u8string(args.front());
+			return true;
+		}
+
+		output = name + u8" = " + entry.getValue();
+		return true;
+	}
+
+	CommandRegistry::Completion CommandRegistry::Complete(std::u8string_view line) const
+	{
+		Completion completion{ .line = std::u8string(line) };
+
+		// Only the name at the start of the line is completed
+		const size_t start = line.find_first_not_of(u8' ');
+		if (start == std::u8string_view::npos || line.find(u8' ', start) != std::u8string_view::npos)
+		{
+			return completion;
+		}
+
+		const auto prefix = line.substr(start);
+		for (const auto& [name, entry] : m_entries)
+		{
+			if (name.starts_with(prefix))
+			{
+				completion.candidates.emplace_back(name);
+			}
+		}
+
+		if (completion.candidates.empty())
+		{
+			return completion;
+		}
+
+		std::ranges::sort(completion.candidates);
+
+		// Extend the line to the longest prefix shared by all candidates
+		std::u8string_view common = completion.candidates.front();
+		for (const auto& candidate : completion.candidates)
+		{
+			auto [commonEnd, candidateEnd] = std::ranges::mismatch(common, candidate);
+			common = common.substr(0, commonEnd - common.begin());
+		}
+
+		completion.line = std::u8string(line.substr(0, start)) + std::u8string(common);
+		if (completion.candidates.size() == 1)
+		{
+			completion.line += u8' ';
+		}
+		return completion;
+	}
+
+	std::u8string CommandRegistry::GetHelp() const
+	{
+		std::vector<std::u8string_view> names;
+		names.reserve(m_entries.size());
+		for (const auto& [name, entry] : m_entries)
+		{
+			names.emplace_back(name);
+		}
+		std::ranges::sort(names);
+
+		std::u8string help;
+		for (const auto& name : names)
+		{
+			const auto& entry = m_entries.find(name)->second;
+			if (!help.empty())
+			{
+				help += u8'\n';
+			}
+
+			help += name;
+			if (!entry.command)
+			{
+				help += u8" = " + entry.getValue();
+			}
+			help += u8" - " + entry.description;
+		}
+		return help;
+	}
+
+	void CommandRegistry::AddEntry(std::u8string_view name, Entry&& entry)
+	{
+		if (auto it = m_entries.find(name); it != m_entries.end())
+		{
+			it->second = std::move(entry);
+			return;
+		}
+
+		m_entries.emplace(std::u8string(name), std::move(entry));
+	}
+} // namespace engine
+} // namespace nu
\ No newline at end of file
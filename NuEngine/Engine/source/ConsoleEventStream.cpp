@@ -2,9 +2,13 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <thread>
+#include <utility>
 
 #include "NuEngine/Assertions.h"
 #include "NuEngine/Console.h"
+#include "NuEngine/Profiler.h"
 
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -19,14 +23,200 @@ namespace console
 	{
 		m_cachedConsoleState = CacheConsoleState();
 		VerifyElseCrash(EnableInputRecords());
+
+		m_hInputQueuedEvent = ::CreateEvent(nullptr, FALSE /*bManualReset*/, FALSE /*bInitialState*/, nullptr);
+		VerifyElseCrash(m_hInputQueuedEvent != nullptr);
+		m_hWakeEvent = ::CreateEvent(nullptr, FALSE /*bManualReset*/, FALSE /*bInitialState*/, nullptr);
+		VerifyElseCrash(m_hWakeEvent != nullptr);
 	}
 
 	ConsoleEventStream::~ConsoleEventStream()
 	{
+		StopInputThread();
+		::CloseHandle(m_hWakeEvent);
+		::CloseHandle(m_hInputQueuedEvent);
 		RestoreConsoleState(m_cachedConsoleState);
 	}
 
+	namespace
+	{
+		// Maximum number of input records read from the console at once
+		constexpr DWORD eventsPerLoop = 512;
+
+		// Longest reply to a cursor position request: ESC [ <row> ; <column> R with five digit coordinates
+		constexpr size_t maxStatusReportLength = 14;
+
+		// How long events that may start a status report reply are held back. The console writes a reply all at once,
+		// so this only delays an escape key press that happened to arrive while a reply was expected.
+		constexpr auto statusReportHoldTime = std::chrono::milliseconds(50);
+
+		// How long a cursor position request may go unanswered before the console is assumed not to support them
+		constexpr auto statusReportAbandonTime = std::chrono::seconds(5);
+
+		// Converts a console input record into an InputEvent; returns false for records that aren't forwarded
+		bool TryDecodeInputRecord(const INPUT_RECORD& record, std::chrono::steady_clock::time_point timestamp, InputEvent& event)
+		{
+			switch (record.EventType)
+			{
+				case WINDOW_BUFFER_SIZE_EVENT:
+					event.type = InputEvent::Type::Resize;
+					event.width = record.Event.WindowBufferSizeEvent.dwSize.X;
+					event.height = record.Event.WindowBufferSizeEvent.dwSize.Y;
+					event.timestamp = timestamp;
+					return true;
+				case KEY_EVENT:
+					event.type = InputEvent::Type::Key;
+					event.isKeyDown = record.Event.KeyEvent.bKeyDown;
+					event.virtualKeyCode = record.Event.KeyEvent.wVirtualKeyCode;
+					event.character = record.Event.KeyEvent.uChar.UnicodeChar;
+					event.timestamp = timestamp;
+					return true;
+				default:
+					return false;
+			}
+		}
+	} // namespace
+
 	void ConsoleEventStream::ProcessEvents()
+	{
+		NU_PROFILE_SCOPE("ProcessEvents");
+
+		// Drain events queued by the input thread. Once stopped, any events it left behind are still delivered.
+		InputEvent event;
+		while (m_inputQueue.TryPop(event))
+		{
+			DispatchEvent(event);
+		}
+
+		if (!IsInputThreadRunning())
+		{
+			PollEvents();
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		while (!m_pendingStatusReports.empty() && now - m_pendingStatusReports.front().sendTime > statusReportAbandonTime)
+		{
+			m_pendingStatusReports.pop_front();
+		}
+
+		if (!m_statusReportEvents.empty() && now - m_statusReportEvents.front().timestamp > statusReportHoldTime)
+		{
+			DispatchHeldStatusReportEvents();
+		}
+	}
+
+	void ConsoleEventStream::ExpectStatusReport(std::chrono::steady_clock::time_point sendTime)
+	{
+		m_pendingStatusReports.push_back({ .sendTime = sendTime });
+	}
+
+	void ConsoleEventStream::CancelStatusReports() noexcept
+	{
+		for (auto& pendingStatusReport : m_pendingStatusReports)
+		{
+			pendingStatusReport.isTimed = false;
+		}
+	}
+
+	bool ConsoleEventStream::WaitForEvents(std::chrono::steady_clock::duration timeout)
+	{
+		// The input thread may have queued events without them being waited for
+		if (IsInputThreadRunning() && !m_inputQueue.IsEmpty())
+		{
+			return true;
+		}
+
+		// The console input handle is signaled while it holds unread input records. With the input thread running, it
+		// reads them as soon as they arrive, so wait for it to queue events instead.
+		const std::array<HANDLE, 2> handles{ IsInputThreadRunning() ? m_hInputQueuedEvent : m_cachedConsoleState.hIn, m_hWakeEvent };
+		DWORD timeoutMs = INFINITE;
+		if (timeout < std::chrono::milliseconds(INFINITE))
+		{
+			timeoutMs = static_cast<DWORD>(std::max<int64_t>(std::chrono::ceil<std::chrono::milliseconds>(timeout).count(), 0));
+		}
+
+		const DWORD waitResult = ::WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE /*bWaitAll*/, timeoutMs);
+		return waitResult == WAIT_OBJECT_0 || waitResult == WAIT_OBJECT_0 + 1;
+	}
+
+	void ConsoleEventStream::Wake()
+	{
+		::SetEvent(m_hWakeEvent);
+	}
+
+	void ConsoleEventStream::StartInputThread()
+	{
+		if (IsInputThreadRunning())
+		{
+			return;
+		}
+
+		m_hStopInputThreadEvent = ::CreateEvent(nullptr, TRUE /*bManualReset*/, FALSE /*bInitialState*/, nullptr);
+		VerifyElseCrash(m_hStopInputThreadEvent != nullptr);
+		m_inputThread = std::jthread([this](std::stop_token stopToken) { RunInputThread(stopToken); });
+	}
+
+	void ConsoleEventStream::StopInputThread()
+	{
+		if (!IsInputThreadRunning())
+		{
+			return;
+		}
+
+		m_inputThread.request_stop();
+		::SetEvent(m_hStopInputThreadEvent);
+		m_inputThread.join();
+		m_inputThread = std::jthread();
+
+		::CloseHandle(m_hStopInputThreadEvent);
+		m_hStopInputThreadEvent = nullptr;
+	}
+
+	void ConsoleEventStream::RunInputThread(std::stop_token stopToken)
+	{
+		const std::array<HANDLE, 2> handles{ m_cachedConsoleState.hIn, m_hStopInputThreadEvent };
+		std::array<INPUT_RECORD, eventsPerLoop> inputRecords;
+		while (!stopToken.stop_requested())
+		{
+			// Block until input is available or the thread is asked to stop
+			DWORD waitResult = ::WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE /*bWaitAll*/, INFINITE);
+			if (waitResult != WAIT_OBJECT_0)
+			{
+				break;
+			}
+
+			DWORD eventsRead = 0;
+			if (!::ReadConsoleInput(m_cachedConsoleState.hIn, inputRecords.data(), eventsPerLoop, &eventsRead))
+			{
+				break;
+			}
+
+			const auto timestamp = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < eventsRead; ++i)
+			{
+				InputEvent event;
+				if (!TryDecodeInputRecord(inputRecords[i], timestamp, event))
+				{
+					continue;
+				}
+
+				// The game thread drains the queue every frame, so it's only full if the game stalls. Wait rather than drop input.
+				while (!m_inputQueue.TryPush(event))
+				{
+					if (stopToken.stop_requested())
+					{
+						return;
+					}
+					std::this_thread::yield();
+				}
+			}
+
+			// Wake any wait for events
+			::SetEvent(m_hInputQueuedEvent);
+		}
+	}
+
+	void ConsoleEventStream::PollEvents()
 	{
 		if (m_keyInputMode == KeyInputMode::Lines)
 		{
@@ -36,46 +226,23 @@ namespace console
 			while (_kbhit())
 			{
 				wint_t ch = _getwch();
-
-				// Check for surrogate pair in UTF-16 input
-				if (ch >= 0xD800 && ch <= 0xDFFF)
-				{
-					m_currentLine += ch;
-					m_currentLine += _getwch(); // Read the next surrogate pair character
-					m_isCurrentLineUtf8Valid = false;
-					continue;
-				}
+				const auto timestamp = std::chrono::steady_clock::now();
 
 				if (ch == 0xE0)
 				{
-					m_currentLine += ch;
-					m_currentLine += _getwch(); // Read the extended key code
-					m_isCurrentLineUtf8Valid = false;
+					HandleLineExtendedKey(_getwch(), timestamp); // Read the extended key code
 					continue;
 				}
 
-				if (ch == VK_RETURN)
+				const InputEvent event{ .type = InputEvent::Type::Key, .isKeyDown = true, .character = static_cast<wchar_t>(ch), .timestamp = timestamp };
+				if (!TryConsumeStatusReport(event))
 				{
-					for (auto* consumer : m_keyConsumers)
-					{
-						if (consumer->OnLineInput(GetCurrentLine()))
-						{
-							break;
-						}
-					}
-
-					m_currentLine.clear();
-					m_isCurrentLineUtf8Valid = false;
-					continue;
+					HandleLineCharacter(ch, timestamp);
 				}
-
-				m_currentLine += ch;
-				m_isCurrentLineUtf8Valid = false;
 			}
 		}
 
 		// Process input events
-		constexpr DWORD eventsPerLoop = 512;
 		std::array<INPUT_RECORD, eventsPerLoop> inputRecords;
 		DWORD eventsToRead = 0;
 		while (::GetNumberOfConsoleInputEvents(m_cachedConsoleState.hIn, &eventsToRead) && eventsToRead > 0)
@@ -87,199 +254,348 @@ namespace console
 				break;
 			}
 
+			const auto timestamp = std::chrono::steady_clock::now();
 			for (size_t i = 0; i < eventsRead; ++i)
 			{
-				switch (inputRecords[i].EventType)
+				InputEvent event;
+				if (!TryDecodeInputRecord(inputRecords[i], timestamp, event))
 				{
-					case WINDOW_BUFFER_SIZE_EVENT:
-					{
-						const auto& resizeEvent = inputRecords[i].Event.WindowBufferSizeEvent;
-						uint16_t newWidth = resizeEvent.dwSize.X;
-						uint16_t newHeight = resizeEvent.dwSize.Y;
-
-						for (auto* consumer : m_resizeConsumers)
-						{
-							consumer->OnWindowResize(newWidth, newHeight);
-						}
-						break;
-					}
-					case KEY_EVENT:
-					{
-						// Discard key events if not in Keys input mode
-						if (m_keyInputMode != KeyInputMode::Keys)
-						{
-							break;
-						}
-
-						const auto& keyEvent = inputRecords[i].Event.KeyEvent;
-						auto [wasKeyMapped, key] = TryMapKey(keyEvent.wVirtualKeyCode);
-						if (!wasKeyMapped)
-						{
-							break;
-						}
-
-						if (keyEvent.bKeyDown)
-						{
-							for (auto* consumer : m_keyConsumers)
-							{
-								if (consumer->OnKeyDown(key))
-								{
-									break;
-								}
-							}
-						}
-						else
-						{
-							for (auto* consumer : m_keyConsumers)
-							{
-								if (consumer->OnKeyUp(key))
-								{
-									break;
-								}
-							}
-						}
-						break;
-					}
-					default:
-						break;
+					continue;
 				}
+
+				// Key events were already consumed as text by _getwch in Lines input mode
+				if (event.type == InputEvent::Type::Key && m_keyInputMode != KeyInputMode::Keys)
+				{
+					continue;
+				}
+
+				DispatchEvent(event);
 			}
 		}
 	}
 
-	void ConsoleEventStream::RegisterKeyboardInputConsumer(IKeyboardInputConsumer* consumer)
+	void ConsoleEventStream::DispatchEvent(const InputEvent& event)
 	{
-		m_keyConsumers.emplace_back(consumer);
-	}
+		if (TryConsumeStatusReport(event))
+		{
+			return;
+		}
 
-	void ConsoleEventStream::UnregisterKeyboardInputConsumer(IKeyboardInputConsumer* consumer)
-	{
-		std::erase(m_keyConsumers, consumer);
+		if (event.type == InputEvent::Type::Resize)
+		{
+			for (auto* consumer : m_resizeConsumers)
+			{
+				consumer->OnWindowResize(event.width, event.height);
+			}
+			return;
+		}
+
+		if (m_keyInputMode == KeyInputMode::Keys)
+		{
+			DispatchKeyEvent(event);
+			return;
+		}
+
+		// Lines input mode: translate key presses into the same characters and extended key codes produced by _getwch
+		if (!event.isKeyDown)
+		{
+			return;
+		}
+
+		switch (event.virtualKeyCode)
+		{
+			case VK_LEFT:
+				HandleLineExtendedKey(0x4B, event.timestamp);
+				break;
+			case VK_RIGHT:
+				HandleLineExtendedKey(0x4D, event.timestamp);
+				break;
+			case VK_UP:
+				HandleLineExtendedKey(0x48, event.timestamp);
+				break;
+			case VK_DOWN:
+				HandleLineExtendedKey(0x50, event.timestamp);
+				break;
+			case VK_HOME:
+				HandleLineExtendedKey(0x47, event.timestamp);
+				break;
+			case VK_END:
+				HandleLineExtendedKey(0x4F, event.timestamp);
+				break;
+			case VK_DELETE:
+				HandleLineExtendedKey(0x53, event.timestamp);
+				break;
+			default:
+				if (event.character != 0)
+				{
+					HandleLineCharacter(event.character, event.timestamp);
+				}
+				break;
+		}
 	}
 
-	void ConsoleEventStream::RegisterWindowResizeConsumer(IWindowResizeConsumer* consumer)
+	bool ConsoleEventStream::TryConsumeStatusReport(const InputEvent& event)
 	{
-		m_resizeConsumers.emplace_back(consumer);
+		if (m_isDispatchingHeldStatusReportEvents || event.type != InputEvent::Type::Key)
+		{
+			return false;
+		}
+
+		// Releases of keys pressed for the reply's characters go with them, including those that follow a complete reply
+		const wchar_t ch = event.character;
+		if (!event.isKeyDown)
+		{
+			if (!m_statusReportEvents.empty())
+			{
+				m_statusReportEvents.push_back(event);
+				return true;
+			}
+			return m_isReleasingStatusReport && (ch == L'\x1b' || ch == L'[' || (ch >= L'0' && ch <= L'9') || ch == L';' || ch == L'R');
+		}
+
+		m_isReleasingStatusReport = false;
+		if (!IsStatusReportPending())
+		{
+			return false;
+		}
+
+		// The reply is ESC [ <row> ; <column> R
+		const bool isExpected = m_statusReportLength == 0 ? ch == L'\x1b'
+		                      : m_statusReportLength == 1 ? ch == L'['
+		                      : (ch >= L'0' && ch <= L'9') || ch == L';' || ch == L'R';
+		if (isExpected && m_statusReportLength < maxStatusReportLength)
+		{
+			m_statusReportEvents.push_back(event);
+			++m_statusReportLength;
+			if (ch == L'R')
+			{
+				// The console answers in order, so this answers the oldest request
+				const auto pendingStatusReport = m_pendingStatusReports.front();
+				m_pendingStatusReports.pop_front();
+				if (pendingStatusReport.isTimed)
+				{
+					m_statusReportRoundTrip = event.timestamp - pendingStatusReport.sendTime;
+				}
+				m_statusReportEvents.clear();
+				m_statusReportLength = 0;
+				m_isReleasingStatusReport = true;
+			}
+			return true;
+		}
+
+		if (m_statusReportEvents.empty())
+		{
+			return false;
+		}
+
+		// Not a reply after all, e.g. an escape key press; dispatch what was held back, then look at this event afresh
+		DispatchHeldStatusReportEvents();
+		return TryConsumeStatusReport(event);
 	}
 
-	void ConsoleEventStream::UnregisterWindowResizeConsumer(IWindowResizeConsumer* consumer)
+	void ConsoleEventStream::DispatchHeldStatusReportEvents()
 	{
-		std::erase(m_resizeConsumers, consumer);
+		// Swap into a local so events held back while dispatching can't invalidate the iteration; keeps the capacity
+		std::vector<InputEvent> events;
+		events.swap(m_statusReportEvents);
+		m_statusReportLength = 0;
+
+		m_isDispatchingHeldStatusReportEvents = true;
+		for (const auto& event : events)
+		{
+			DispatchEvent(event);
+		}
+		m_isDispatchingHeldStatusReportEvents = false;
+
+		events.clear();
+		m_statusReportEvents.swap(events);
 	}
 
-	void ConsoleEventStream::SetKeyInputMode(KeyInputMode mode)
+	void ConsoleEventStream::DispatchKeyEvent(const InputEvent& event)
 	{
-		if (m_keyInputMode == mode)
+		auto [wasKeyMapped, key] = TryMapKey(event.virtualKeyCode);
+		if (!wasKeyMapped)
 		{
 			return;
 		}
 
-		if (m_keyInputMode == KeyInputMode::Lines)
+		bool wasConsumed = event.isKeyDown ? m_keyboardState.SetKeyDown(key) : m_keyboardState.SetKeyUp(key);
+		if (m_areKeyCallbacksEnabled)
 		{
-			m_currentLine.clear();
-			m_currentLineUtf8.clear();
+			for (auto* consumer : m_keyConsumers)
+			{
+				if (event.isKeyDown ? consumer->OnKeyDown(key) : consumer->OnKeyUp(key))
+				{
+					wasConsumed = true;
+					break;
+				}
+			}
 		}
 
-		m_keyInputMode = mode;
+		if (wasConsumed)
+		{
+			RecordConsumedInput(event.timestamp);
+		}
 	}
 
-	const std::u8string& ConsoleEventStream::GetCurrentLine()
+	void ConsoleEventStream::HandleLineCharacter(wchar_t ch, std::chrono::steady_clock::time_point timestamp)
 	{
-		if (m_isCurrentLineUtf8Valid)
+		RecordConsumedInput(timestamp);
+
+		// Combine surrogate pairs in UTF-16 input into a single code point
+		if (ch >= 0xD800 && ch <= 0xDBFF)
 		{
-			return m_currentLineUtf8;
+			m_pendingHighSurrogate = ch;
+			return;
 		}
 
-		// Process control characters if present
-		std::wstring processedLine;
-		size_t cursor = 0;
-		for (size_t i = 0; i < m_currentLine.size(); ++i)
+		if (ch >= 0xDC00 && ch <= 0xDFFF)
 		{
-			wchar_t ch = m_currentLine[i];
-			switch (ch)
+			if (m_pendingHighSurrogate != 0)
 			{
-				case '\b': // Backspace
+				m_lineEditor.Insert(0x10000 + ((static_cast<char32_t>(m_pendingHighSurrogate) - 0xD800) << 10) + (ch - 0xDC00));
+				m_pendingHighSurrogate = 0;
+			}
+			return;
+		}
 
-					if (cursor > 0)
-					{
-						processedLine.erase(cursor - 1 /*Off*/, 1 /*Count*/);
-						--cursor;
-					}
-					break;
-				case 0xE0: // Extended key
-					if (i < m_currentLine.size() - 1)
-					{
-						switch (m_currentLine[i + 1])
-						{
-							case 0x4B: // Left arrow
-								if (cursor > 0)
-								{
-									--cursor;
-								}
-								break;
-							case 0x4D: // Right arrow
-								if (cursor < processedLine.size())
-								{
-									++cursor;
-								}
-								break;
-							case 0x47: // Home
-								cursor = 0;
-								break;
-							case 0x4F: // End
-								cursor = processedLine.size();
-								break;
-							case 0x53: // Delete
-								if (!processedLine.empty() && cursor < processedLine.size())
-								{
-									processedLine.erase(cursor /*Off*/, 1 /*Count*/);
-								}
-								break;
-							default:
-								break;
-						}
-						++i;
-					}
-					break;
-				default:
-					if (cursor == processedLine.size())
-					{
-						processedLine += ch;
-					}
-					else
+		m_pendingHighSurrogate = 0;
+		switch (ch)
+		{
+			case VK_RETURN:
+			{
+				const auto& line = m_lineEditor.GetText();
+				for (auto* consumer : m_keyConsumers)
+				{
+					if (consumer->OnLineInput(line))
 					{
-						processedLine.insert(cursor /*Off*/, 1 /*Count*/, ch);
+						break;
 					}
-					++cursor;
-					break;
+				}
+
+				m_lineEditor.Commit();
+				break;
 			}
+			case VK_BACK:
+				m_lineEditor.Backspace();
+				break;
+			case VK_TAB:
+				if (m_lineCompletionHandler)
+				{
+					m_lineEditor.SetText(m_lineCompletionHandler(m_lineEditor.GetText()));
+				}
+				break;
+			case VK_ESCAPE:
+			case static_cast<wchar_t>(Key::GraveAccent):
+				m_isLineInputCancelled = true;
+				break;
+			default:
+				// Ignore any other control characters
+				if (ch >= 0x20)
+				{
+					m_lineEditor.Insert(static_cast<char32_t>(ch));
+				}
+				break;
+		}
+	}
+
+	void ConsoleEventStream::HandleLineExtendedKey(wchar_t scanCode, std::chrono::steady_clock::time_point timestamp)
+	{
+		RecordConsumedInput(timestamp);
+
+		switch (scanCode)
+		{
+			case 0x4B: // Left arrow
+				m_lineEditor.MoveLeft();
+				break;
+			case 0x4D: // Right arrow
+				m_lineEditor.MoveRight();
+				break;
+			case 0x48: // Up arrow
+				m_lineEditor.HistoryPrevious();
+				break;
+			case 0x50: // Down arrow
+				m_lineEditor.HistoryNext();
+				break;
+			case 0x47: // Home
+				m_lineEditor.MoveHome();
+				break;
+			case 0x4F: // End
+				m_lineEditor.MoveEnd();
+				break;
+			case 0x53: // Delete
+				m_lineEditor.Delete();
+				break;
+			default:
+				break;
 		}
+	}
 
-		// Check if there's any characters left to convert
-		m_currentLineUtf8.clear();
-		if (processedLine.empty())
+	void ConsoleEventStream::RecordConsumedInput(std::chrono::steady_clock::time_point timestamp) noexcept
+	{
+		auto& summary = m_consumedInputSummary;
+		if (summary.count == 0)
 		{
-			m_isCurrentLineUtf8Valid = true;
-			return m_currentLineUtf8;
+			summary.oldest = timestamp;
+		}
+		else if (timestamp < summary.oldest)
+		{
+			// Rebase the sum on the new oldest timestamp
+			summary.totalSinceOldest += (summary.oldest - timestamp) * summary.count;
+			summary.oldest = timestamp;
 		}
 
-		// Convert from UTF-16 wide string to UTF-8
-		int requiredSize = ::WideCharToMultiByte(CP_UTF8, 0, processedLine.c_str(), static_cast<int>(processedLine.size()), nullptr, 0, nullptr, nullptr);
-		VerifyElseCrash(requiredSize > 0);
+		++summary.count;
+		summary.newest = std::max(summary.newest, timestamp);
+		summary.totalSinceOldest += timestamp - summary.oldest;
+	}
 
-		m_currentLineUtf8.resize(requiredSize);
-		::WideCharToMultiByte(
-			CP_UTF8,
-			0,
-			processedLine.c_str(),
-			static_cast<int>(processedLine.size()),
-			reinterpret_cast<char*>(m_currentLineUtf8.data()),
-			requiredSize,
-			nullptr,
-			nullptr);
+	ConsumedInputSummary ConsoleEventStream::TakeConsumedInputSummary() noexcept
+	{
+		return std::exchange(m_consumedInputSummary, ConsumedInputSummary{});
+	}
 
-		m_isCurrentLineUtf8Valid = true;
-		return m_currentLineUtf8;
+	void ConsoleEventStream::RegisterKeyboardInputConsumer(IKeyboardInputConsumer* consumer)
+	{
+		m_keyConsumers.emplace_back(consumer);
+	}
+
+	void ConsoleEventStream::UnregisterKeyboardInputConsumer(IKeyboardInputConsumer* consumer)
+	{
+		std::erase(m_keyConsumers, consumer);
+	}
+
+	void ConsoleEventStream::RegisterWindowResizeConsumer(IWindowResizeConsumer* consumer)
+	{
+		m_resizeConsumers.emplace_back(consumer);
+	}
+
+	void ConsoleEventStream::UnregisterWindowResizeConsumer(IWindowResizeConsumer* consumer)
+	{
+		std::erase(m_resizeConsumers, consumer);
+	}
+
+	void ConsoleEventStream::SetKeyInputMode(KeyInputMode mode)
+	{
+		if (m_keyInputMode == mode)
+		{
+			return;
+		}
+
+		if (m_keyInputMode == KeyInputMode::Lines)
+		{
+			m_lineEditor.Clear();
+			m_pendingHighSurrogate = 0;
+			m_isLineInputCancelled = false;
+		}
+
+		// Key releases aren't delivered in Lines input mode, so don't leave keys stuck down
+		if (mode == KeyInputMode::Lines)
+		{
+			m_keyboardState.ReleaseAll();
+		}
+
+		m_keyInputMode = mode;
 	}
 
 	/*static*/ std::pair<bool, Key> ConsoleEventStream::TryMapKey(uint16_t virtualKeyCode)
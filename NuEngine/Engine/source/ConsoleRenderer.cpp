@@ -4,9 +4,12 @@
 #include <chrono>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 #include "NuEngine/Assertions.h"
 #include "NuEngine/Console.h"
+#include "NuEngine/Profiler.h"
+#include "NuEngine/Stopwatch.h"
 
 using namespace std::chrono_literals;
 
@@ -14,6 +17,31 @@ namespace nu
 {
 namespace console
 {
+	namespace
+	{
+		// Backgrounds of the heatmap levels; level 0 keeps the glyph's own background
+		constexpr std::array<std::string_view, 4> heatmapColors = {
+			std::string_view(),
+			vt::color::BackgroundGreen,
+			vt::color::BackgroundYellow,
+			vt::color::BackgroundRed,
+		};
+
+		uint8_t GetHeatmapLevel(HeatmapMode heatmapMode, uint32_t writes, uint8_t changeHeat)
+		{
+			switch (heatmapMode)
+			{
+				case HeatmapMode::Overdraw:
+					return static_cast<uint8_t>(std::min<uint32_t>(writes, 3));
+				case HeatmapMode::Changes:
+					return changeHeat >= 128 ? 3 : changeHeat >= 16 ? 2 : changeHeat > 0 ? 1 : 0;
+				case HeatmapMode::None:
+				default:
+					return 0;
+			}
+		}
+	} // namespace
+
 	ConsoleRenderer::ConsoleRenderer()
 	{
 		m_cachedConsoleState = CacheConsoleState();
@@ -37,6 +65,7 @@ namespace console
 
 	ConsoleRenderer::~ConsoleRenderer()
 	{
+		StopOutputThread();
 		std::cout << vt::UseMainScreenBuffer;
 		RestoreConsoleState(m_cachedConsoleState);
 	}
@@ -48,6 +77,14 @@ namespace console
 			         .backgroundColor = std::string(backgroundColor),
 			         .lastDrawnId = m_currentPresentId };
 		std::ranges::fill(GetBackBuffer(), glyph);
+
+		if (IsCountingCells())
+		{
+			for (auto& writes : m_cellWrites)
+			{
+				++writes;
+			}
+		}
 	}
 
 	bool ConsoleRenderer::DrawChar(uint16_t x, uint16_t y, char character, std::string_view foregroundColor, std::string_view backgroundColor)
@@ -57,11 +94,13 @@ namespace console
 			return false;
 		}
 
-		Glyph& glyph = GetBackBuffer()[y * m_sizeX + x];
+		const size_t index = y * m_sizeX + x;
+		Glyph& glyph = GetBackBuffer()[index];
 		glyph.character = character;
 		glyph.foregroundColor.assign(foregroundColor);
 		glyph.backgroundColor.assign(backgroundColor);
 		glyph.lastDrawnId = m_currentPresentId;
+		CountCellWrite(index);
 		return true;
 	}
 
@@ -75,11 +114,13 @@ namespace console
 		auto [extractedCharacter, remainingView] = ReadNextU8Char(character);
 		VerifyElseCrash(remainingView.empty()); // Ensure that the input is exactly one character
 
-		Glyph& glyph = GetBackBuffer()[y * m_sizeX + x];
+		const size_t index = y * m_sizeX + x;
+		Glyph& glyph = GetBackBuffer()[index];
 		glyph.character = extractedCharacter;
 		glyph.foregroundColor.assign(foregroundColor);
 		glyph.backgroundColor.assign(backgroundColor);
 		glyph.lastDrawnId = m_currentPresentId;
+		CountCellWrite(index);
 		return true;
 	}
 
@@ -116,6 +157,15 @@ namespace console
 
 	void ConsoleRenderer::Present()
 	{
+		// Under backpressure, drop the frame without flipping, so the front buffer stays what the console last received
+		const bool isAsync = IsAsyncPresentEnabled();
+		if (isAsync && m_isOutputThreadWriting.load(std::memory_order_acquire))
+		{
+			DiscardFrame();
+			m_lastPresentStatistics = PresentStatistics{ .isCoalesced = true };
+			return;
+		}
+
 		// Get references to the buffers
 		auto& backBuffer = GetBackBuffer();
 		auto& frontBuffer = GetFrontBuffer();
@@ -125,75 +175,141 @@ namespace console
 		auto clearGlyph = Glyph{};
 		clearGlyph.lastDrawnId = m_currentPresentId;
 
-		// Update any positions on the console that have changed
-		// Don't send straight to std::cout to avoid the update being visible in an inconsistent state
-		m_builder.clear();
-		int cursorX = 0;
-		int cursorY = 0;
-		std::string backgroundColor;
-		std::string foregroundColor;
-		for (int i = 0; i < backBuffer.size(); ++i)
-		{
-			// Clear the glyph if it wasn't drawn to this frame and incremental drawing is disabled
-			bool shouldUseClearGlyph = backBuffer[i].lastDrawnId != m_currentPresentId && !m_enableIncrementalDrawing;
-			if (shouldUseClearGlyph)
-			{
-				backBuffer[i] = clearGlyph;
-			}
+		const bool isCountingCells = IsCountingCells();
+		CellStatistics cellStatistics;
+		PresentStatistics presentStatistics;
+		presentStatistics.scannedCells = static_cast<uint32_t>(backBuffer.size());
 
-			const auto& backGlyph = backBuffer[i];
-			const auto& frontGlyph = frontBuffer[i];
-			if (backGlyph == frontGlyph && !m_shouldDrawAllGlyphs)
-			{
-				continue;
-			}
-
-			const int x = i % m_sizeX + 1;
-			const int y = i / m_sizeX + 1;
-			if (cursorX != x || cursorY != y || i == 0)
-			{
-				m_builder += vt::cursor::SetPosition(x, y);
-				cursorX = x;
-				cursorY = y;
-			}
-
-			if (foregroundColor != backGlyph.foregroundColor || i == 0)
-			{
-				m_builder += backGlyph.foregroundColor;
-				foregroundColor = backGlyph.foregroundColor;
-			}
-
-			if (backgroundColor != backGlyph.backgroundColor || i == 0)
-			{
-				m_builder += backGlyph.backgroundColor;
-				backgroundColor = backGlyph.backgroundColor;
-			}
-
-			for (char8_t c : backGlyph.character)
-			{
-				// Character may have multiple UTF-8 code points
-				m_builder += c;
-			}
-
-			if (++cursorX > m_sizeX)
+		{
+			NU_PROFILE_SCOPE("Present::Build");
+
+			// Update any positions on the console that have changed
+			// Don't send straight to std::cout to avoid the update being visible in an inconsistent state
+			m_builder.clear();
+			int cursorX = 0;
+			int cursorY = 0;
+			// Views into glyphs already visited, which aren't modified again during Present
+			std::string_view backgroundColor;
+			std::string_view foregroundColor;
+			for (int i = 0; i < backBuffer.size(); ++i)
 			{
-				++cursorY;
-				cursorX = 1;
+				// Clear the glyph if it wasn't drawn to this frame and incremental drawing is disabled
+				bool shouldUseClearGlyph = backBuffer[i].lastDrawnId != m_currentPresentId && !m_enableIncrementalDrawing;
+				if (shouldUseClearGlyph)
+				{
+					backBuffer[i] = clearGlyph;
+				}
+
+				const auto& backGlyph = backBuffer[i];
+				const auto& frontGlyph = frontBuffer[i];
+				const bool isChanged = m_shouldDrawAllGlyphs || !(backGlyph == frontGlyph);
+
+				// The heatmap tints the output only, so cells whose tint changed are written even if their glyph didn't
+				uint8_t heatmapLevel = 0;
+				if (isCountingCells)
+				{
+					const uint32_t writes = std::exchange(m_cellWrites[i], 0);
+					auto& changeHeat = m_cellChangeHeat[i];
+					changeHeat = isChanged ? 255 : changeHeat / 2;
+					heatmapLevel = GetHeatmapLevel(m_heatmapMode, writes, changeHeat);
+
+					cellStatistics.cellWrites += writes;
+					cellStatistics.overdrawnCells += writes > 1 ? 1 : 0;
+				}
+				presentStatistics.changedCells += isChanged ? 1 : 0;
+
+				if (!isChanged && heatmapLevel == m_cellHeatLevels[i])
+				{
+					continue;
+				}
+				m_cellHeatLevels[i] = heatmapLevel;
+
+				const int x = i % m_sizeX + 1;
+				const int y = i / m_sizeX + 1;
+				if (cursorX != x || cursorY != y || i == 0)
+				{
+					const size_t builderSize = m_builder.size();
+					vt::cursor::SetPosition(x, y, m_builder);
+					cursorX = x;
+					cursorY = y;
+					presentStatistics.cursorBytes += m_builder.size() - builderSize;
+					++presentStatistics.runs;
+				}
+
+				if (foregroundColor != backGlyph.foregroundColor || i == 0)
+				{
+					m_builder += backGlyph.foregroundColor;
+					foregroundColor = backGlyph.foregroundColor;
+					presentStatistics.colorBytes += backGlyph.foregroundColor.size();
+				}
+
+				const std::string_view cellBackgroundColor = heatmapLevel > 0 ? heatmapColors[heatmapLevel] : backGlyph.backgroundColor;
+				if (backgroundColor != cellBackgroundColor || i == 0)
+				{
+					m_builder += cellBackgroundColor;
+					backgroundColor = cellBackgroundColor;
+					presentStatistics.colorBytes += cellBackgroundColor.size();
+				}
+
+				for (char8_t c : backGlyph.character)
+				{
+					// Character may have multiple UTF-8 code points
+					m_builder += c;
+				}
+				presentStatistics.textBytes += backGlyph.character.size();
+
+				if (++cursorX > m_sizeX)
+				{
+					++cursorY;
+					cursorX = 1;
+				}
 			}
 		}
 
 		m_shouldDrawAllGlyphs = false;
 		++m_currentPresentId;
+		m_lastCellStatistics = cellStatistics;
 
-		// Push changes to cout
-		if (!m_builder.empty())
+		// After the frame, so the console replies once it has processed the frame, even if nothing changed
+		if (m_isStatusReportRequested)
 		{
+			m_builder += vt::cursor::ReportPosition;
+			presentStatistics.cursorBytes += vt::cursor::ReportPosition.size();
+			presentStatistics.isStatusReportSent = true;
+			m_isStatusReportRequested = false;
+		}
+
+		// Hand changes to the output thread, or push them to cout
+		if (!m_builder.empty() && isAsync)
+		{
+			m_builder += vt::cursor::HideCursor;
+			presentStatistics.cursorBytes += vt::cursor::HideCursor.size();
+
+			std::swap(m_builder, m_output);
+			m_isOutputThreadWriting.store(true, std::memory_order_relaxed);
+			m_outputRequested.release();
+			presentStatistics.writeTime = std::chrono::duration<double>(m_lastOutputWriteSeconds.load(std::memory_order_relaxed));
+			++presentStatistics.writes;
+		}
+		else if (!m_builder.empty())
+		{
+			NU_PROFILE_SCOPE("Present::Write");
 			m_builder += vt::cursor::HideCursor;
+			presentStatistics.cursorBytes += vt::cursor::HideCursor.size();
+
+			nu::engine::Stopwatch writeTimer;
+			writeTimer.Start();
 			std::cout << m_builder;
+			writeTimer.Stop();
+			presentStatistics.writeTime = writeTimer.ElapsedSeconds();
+			++presentStatistics.writes;
 		}
+		m_lastPresentStatistics = presentStatistics;
 
 		if (m_enableIncrementalDrawing)
 		{
+			NU_PROFILE_SCOPE("Present::Copy");
+
 			// Copy the presented buffer if incremental drawing is enabled
 			frontBuffer = backBuffer;
 		}
@@ -214,6 +330,10 @@ namespace console
 				std::ranges::fill(buffer, Glyph{});
 			}
 
+			m_cellWrites.assign(m_sizeY * m_sizeX, 0);
+			m_cellChangeHeat.assign(m_sizeY * m_sizeX, 0);
+			m_cellHeatLevels.assign(m_sizeY * m_sizeX, 0);
+
 			// Force a full redraw on the next present
 			m_shouldDrawAllGlyphs = true;
 		}
@@ -224,6 +344,58 @@ namespace console
 		}
 	}
 
+	void ConsoleRenderer::SetAsyncPresentEnabled(bool enableAsyncPresent)
+	{
+		if (enableAsyncPresent && !m_outputThread.joinable())
+		{
+			m_outputThread = std::jthread([this](std::stop_token stopToken) { RunOutputThread(stopToken); });
+		}
+		else if (!enableAsyncPresent)
+		{
+			StopOutputThread();
+		}
+	}
+
+	void ConsoleRenderer::RunOutputThread(std::stop_token stopToken)
+	{
+		nu::engine::profiler::SetThreadName("Console Output");
+
+		while (true)
+		{
+			m_outputRequested.acquire();
+			if (stopToken.stop_requested())
+			{
+				return;
+			}
+
+			{
+				NU_PROFILE_SCOPE("Present::Write");
+				nu::engine::Stopwatch writeTimer;
+				writeTimer.Start();
+				std::cout << m_output;
+				writeTimer.Stop();
+				m_lastOutputWriteSeconds.store(writeTimer.ElapsedSeconds().count(), std::memory_order_relaxed);
+			}
+
+			m_isOutputThreadWriting.store(false, std::memory_order_release);
+		}
+	}
+
+	void ConsoleRenderer::StopOutputThread()
+	{
+		if (m_outputThread.joinable())
+		{
+			// Let the last handed-over output reach the console, then wake the thread so it sees the stop request
+			while (m_isOutputThreadWriting.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+			m_outputThread.request_stop();
+			m_outputRequested.release();
+			m_outputThread.join();
+		}
+	}
+
 	std::vector<ConsoleRenderer::Glyph>& ConsoleRenderer::GetBackBuffer()
 	{
 		VerifyElseCrash(m_currentBufferIndex < m_buffers.size());
@@ -237,7 +409,7 @@ namespace console
 		return m_buffers[frontBufferIndex];
 	}
 
-	std::pair<std::u8string, std::u8string_view> ConsoleRenderer::ReadNextU8Char(std::u8string_view text)
+	/*static*/ std::pair<std::u8string, std::u8string_view> ConsoleRenderer::ReadNextU8Char(std::u8string_view text)
 	{
 		if (text.empty())
 		{
@@ -1,13 +1,19 @@
 ﻿#include "NuEngine/Engine.h"
 
 #include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <format>
 #include <string_view>
 #include <thread>
 
 #include "NuEngine/Assertions.h"
+#include "NuEngine/Clock.h"
 #include "NuEngine/ConsoleEventStream.h"
 #include "NuEngine/ConsoleRenderer.h"
 #include "NuEngine/Game.h"
+#include "NuEngine/HardwareCounters.h"
+#include "NuEngine/Profiler.h"
 #include "NuEngine/Stopwatch.h"
 
 #define NOMINMAX
@@ -23,6 +29,7 @@ namespace engine
 {
 	Engine::Engine()
 	{
+		RegisterCommands();
 	}
 
 	void Engine::StartGame(Game& game)
@@ -33,6 +40,7 @@ namespace engine
 		ConsoleRenderer renderer;
 		m_renderSizeX = renderer.GetWidth();
 		m_renderSizeY = renderer.GetHeight();
+		m_renderer = &renderer;
 
 		m_game = &game;
 		game.SetEngine(this);
@@ -41,16 +49,45 @@ namespace engine
 		ConsoleEventStream eventStream;
 		eventStream.RegisterKeyboardInputConsumer(this);
 		eventStream.RegisterWindowResizeConsumer(this);
+		m_eventStream = &eventStream;
+		eventStream.SetLineCompletionHandler(
+			[this](std::u8string_view line)
+			{
+				auto completion = m_commands.Complete(line);
+				m_commanderOutput.clear();
+				if (completion.candidates.size() > 1)
+				{
+					for (const auto& candidate : completion.candidates)
+					{
+						m_commanderOutput += candidate;
+						m_commanderOutput += u8"  ";
+					}
+				}
+				return std::move(completion.line);
+			});
+		if (m_isInputThreadEnabled)
+		{
+			eventStream.StartInputThread();
+		}
+
+		profiler::SetThreadName("Main");
 
 		Stopwatch frameTimer;
 		Stopwatch tickTimer;
 		Stopwatch renderTimer;
 		Stopwatch presentTimer;
 		Stopwatch idleTimer;
+		m_lastAllocationSnapshot = allocations::GetSnapshot();
+		m_lastHardwareCounts = hardwareCounters::Read();
 		while (!m_shouldStopGame)
 		{
+			// Collect the last frame's profile events before this frame starts recording its own
+			m_profileCapture.BeginFrame();
+			NU_PROFILE_SCOPE("Frame");
+
 			auto deltaTime = frameTimer.ElapsedSeconds();
 			frameTimer.Restart();
+			allocations::SetFramePhase(FramePhase::Input);
 
 			// Make sure input mode is set correctly based on whether the commander is currently enabled
 			if (m_isCommanderEnabled && eventStream.GetKeyInputMode() == KeyInputMode::Keys)
@@ -63,19 +100,31 @@ namespace engine
 			}
 
 			// Process input and window resize events
+			eventStream.BeginFrame();
+			eventStream.SetKeyCallbacksEnabled(m_areKeyCallbacksEnabled);
 			eventStream.ProcessEvents();
+			UpdateTerminalPacing(eventStream, renderer);
 
-			// Check if commander should be dismissed; this can't use OnKeyDown events, because commander disables them
-			if (m_isCommanderEnabled)
+			// Without callbacks, the engine polls for its own keys
+			if (!m_areKeyCallbacksEnabled && eventStream.GetKeyInputMode() == KeyInputMode::Keys)
 			{
-				const auto& rawLine = eventStream.GetCurrentLineRaw();
-				if (rawLine.find(static_cast<wchar_t>(Key::Escape)) != std::wstring::npos
-				    || rawLine.find(static_cast<wchar_t>(Key::GraveAccent)) != std::wstring::npos)
+				if (eventStream.GetKeyboardState().WasKeyPressed(Key::Escape))
 				{
-					m_isCommanderEnabled = false;
+					StopGame();
+				}
+				else if (eventStream.GetKeyboardState().WasKeyPressed(Key::GraveAccent))
+				{
+					m_isCommanderEnabled = true;
 				}
 			}
 
+			// Check if commander should be dismissed; this can't use OnKeyDown events, because commander disables them
+			if (m_isCommanderEnabled && eventStream.IsLineInputCancelled())
+			{
+				m_isCommanderEnabled = false;
+				m_commanderOutput.clear();
+			}
+
 			// Resize the renderer if necessary
 			if (renderer.GetWidth() != m_renderSizeX || renderer.GetHeight() != m_renderSizeY)
 			{
@@ -83,124 +132,207 @@ namespace engine
 				m_game->OnWindowResize(m_renderSizeX, m_renderSizeY);
 			}
 
-			// Update the simulation
-			tickTimer.Restart();
-			game.Tick(deltaTime);
-			tickTimer.Stop();
-
-			// Draw the game
-			renderTimer.Restart();
-			game.Render(renderer);
-			renderTimer.Stop();
+			// Decide what to skip this frame if the last one ran over, or if presenting would get ahead of the terminal
+			auto frameSkip = ApplyOverloadPolicy();
+			if (frameSkip != FrameSkip::None && m_renderMode == RenderMode::OnDemand)
+			{
+				// Nothing else may run the frame that shows what this one skips
+				RequestRedraw();
+			}
+			else if (frameSkip == FrameSkip::None && IsPresentAheadOfTerminal())
+			{
+				frameSkip = FrameSkip::Present;
+			}
 
-			// Draw the commander
-			if (m_isCommanderEnabled)
+			// Update the simulation. Pipelined, the tick runs on the simulation thread while this frame renders and presents,
+			// and Render receives the interpolation alpha of the previous tick, matching the snapshot it was published with.
+			const bool isTickPipelined = m_isPipelinedTickEnabled;
+			const double interpolationAlpha = m_interpolationAlpha;
+			RecordHardwareCounts(FramePhase::Input);
+			allocations::SetFramePhase(FramePhase::Tick);
+			if (isTickPipelined)
+			{
+				StartTickThread();
+				m_pipelinedDeltaTime = deltaTime;
+				m_tickRequested.release();
+			}
+			else
 			{
-				for (uint16_t x = 0; x < m_renderSizeX; ++x)
+				StopTickThread();
+				tickTimer.Restart();
+				m_lastFrameTimings.ticks = TickGame(deltaTime);
+				tickTimer.Stop();
+
+				// Process input that arrived during Tick so callbacks can apply it right before Render
+				if (m_isLateLatchInputEnabled)
 				{
-					renderer.DrawChar(x, m_renderSizeY - 1, ' ', vt::color::ForegroundBlack, vt::color::BackgroundBrightBlue);
+					eventStream.ProcessEvents();
 				}
-
-				renderer.DrawString(0, m_renderSizeY - 1, "> ", vt::color::ForegroundBrightWhite, vt::color::BackgroundBrightBlue);
-				renderer.DrawU8String(2, m_renderSizeY - 1, eventStream.GetCurrentLine(), vt::color::ForegroundBrightWhite, vt::color::BackgroundBrightBlue);
 			}
 
-			// Render FPS counter, if enabled
-			if (m_showFps)
+			RecordHardwareCounts(FramePhase::Tick);
+			allocations::SetFramePhase(FramePhase::Render);
+			if (frameSkip == FrameSkip::RenderAndPresent)
 			{
-				int fps = static_cast<int>(std::round(1.f / m_lastFrameTimings.totalFrameTime.count()));
-				std::string fpsString = std::format("{} FPS", fps);
-				int x = std::max(0, m_renderSizeX - static_cast<int>(fpsString.size()));
-
-				constexpr int yOffset = 3;
-				int y = std::max(0, m_renderSizeY / 4 - yOffset);
-
-				renderer.DrawString(x, y, fpsString, vt::color::ForegroundBrightCyan);
+				renderTimer.Reset();
 			}
-
-			// Render frame timing stats, if enabled
-			if (m_showFrameTimings)
+			else
 			{
-				constexpr auto frameTimeLabel =   "Frame:   "sv;
-				constexpr auto tickTimeLabel =    "Tick:    "sv;
-				constexpr auto renderTimeLabel =  "Render:  "sv;
-				constexpr auto presentTimeLabel = "Present: "sv;
-				constexpr auto idleTimeLabel =    "Idle:    "sv;
-				constexpr auto labelLength = static_cast<uint16_t>(frameTimeLabel.size());
+				NU_PROFILE_SCOPE("Render");
 
-				auto toMs = [](const auto& duration) { return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(duration).count(); };
-				auto frameTime = std::format("{:>5.2f}ms", toMs(m_lastFrameTimings.totalFrameTime));
-				auto tickTime = std::format("{:>5.2f}ms", toMs(m_lastFrameTimings.tickTime));
-				auto renderTime = std::format("{:>5.2f}ms", toMs(m_lastFrameTimings.renderTime));
-				auto presentTime = std::format("{:>5.2f}ms", toMs(m_lastFrameTimings.presentTime));
-				auto idleTime = std::format("{:>5.2f}ms", toMs(m_lastFrameTimings.idleTime));
+				// Draw the game
+				renderTimer.Restart();
+				game.Render(renderer, isTickPipelined ? interpolationAlpha : m_interpolationAlpha);
+				renderTimer.Stop();
 
-				int timingLength = static_cast<int>(std::max({ frameTime.size(), tickTime.size(), renderTime.size(), presentTime.size(), idleTime.size() }));
-				int x = std::max(0, m_renderSizeX - static_cast<int>(labelLength) - timingLength);
+				// Draw the commander
+				if (m_isCommanderEnabled)
+				{
+					DrawCommander(renderer, eventStream);
+				}
 
-				constexpr int yOffset = 2;
-				int y = std::max(0, m_renderSizeY / 4 - yOffset);
+				// Draw the FPS counter and frame timings, if enabled
+				DrawOverlays(renderer);
+			}
 
-				renderer.DrawString(x, y, frameTimeLabel);
-				renderer.DrawString(x + labelLength, y, frameTime, vt::color::ForegroundBrightWhite);
+			RecordHardwareCounts(FramePhase::Render);
+			allocations::SetFramePhase(FramePhase::Present);
+			bool isPresented = false;
+			if (frameSkip == FrameSkip::None)
+			{
+				NU_PROFILE_SCOPE("Present");
 
-				auto tickColor = tickTime >= renderTime && tickTime >= presentTime ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite;
-				renderer.DrawString(x, ++y, tickTimeLabel);
-				renderer.DrawString(x + labelLength, y, tickTime, tickColor);
+				// Present to the console
+				const auto presentStartTime = std::chrono::steady_clock::now();
+				presentTimer.Restart();
+				renderer.Present();
+				presentTimer.Stop();
 
-				auto renderColor = renderTime >= tickTime && renderTime >= presentTime ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite;
-				renderer.DrawString(x, ++y, renderTimeLabel);
-				renderer.DrawString(x + labelLength, y, renderTime, renderColor);
+				// Async present drops frames while the console is behind; on demand, run another frame so the latest one reaches it
+				const auto& presentStatistics = renderer.GetLastPresentStatistics();
+				isPresented = !presentStatistics.isCoalesced;
+				if (!isPresented && m_renderMode == RenderMode::OnDemand)
+				{
+					RequestRedraw();
+				}
 
-				auto presentColor = presentTime >= tickTime && presentTime >= renderTime ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite;
-				renderer.DrawString(x, ++y, presentTimeLabel);
-				renderer.DrawString(x + labelLength, y, presentTime, presentColor);
+				// The round trip starts with the frame, so it covers the terminal drawing it as well as answering
+				if (isPresented)
+				{
+					m_lastPresentTime = presentStartTime;
+				}
+				if (presentStatistics.isStatusReportSent)
+				{
+					eventStream.ExpectStatusReport(presentStartTime);
+				}
+			}
+			else
+			{
+				presentTimer.Reset();
+				if (frameSkip == FrameSkip::Present)
+				{
+					renderer.DiscardFrame();
+				}
+			}
 
-				renderer.DrawString(x, ++y, idleTimeLabel);
-				renderer.DrawString(x + labelLength, y, idleTime, vt::color::ForegroundBrightWhite);
+			// Wait for the pipelined tick before touching anything it may read
+			if (isTickPipelined)
+			{
+				NU_PROFILE_SCOPE("WaitForTick");
+				m_tickCompleted.acquire();
+				m_lastFrameTimings.ticks = m_pipelinedTicks;
 			}
 
-			// Present to the console
-			presentTimer.Restart();
-			renderer.Present();
-			presentTimer.Stop();
+			// Measure how long consumed input took to reach the console. Input consumed in skipped or dropped frames is counted once presented.
+			const auto presentEndTime = std::chrono::steady_clock::now();
+			const auto consumedInput = isPresented ? eventStream.TakeConsumedInputSummary() : ConsumedInputSummary{};
+			m_lastFrameTimings.inputEventsConsumed = consumedInput.count;
+			if (consumedInput.count > 0)
+			{
+				const auto averageTimestamp = consumedInput.GetAverageTimestamp();
+				m_lastFrameTimings.inputLatencyMin = presentEndTime - consumedInput.newest;
+				m_lastFrameTimings.inputLatencyAverage = presentEndTime - averageTimestamp;
+				m_lastFrameTimings.inputLatencyMax = presentEndTime - consumedInput.oldest;
+			}
+			else
+			{
+				m_lastFrameTimings.inputLatencyMin = std::chrono::duration<double>::zero();
+				m_lastFrameTimings.inputLatencyAverage = std::chrono::duration<double>::zero();
+				m_lastFrameTimings.inputLatencyMax = std::chrono::duration<double>::zero();
+			}
+
+			RecordHardwareCounts(FramePhase::Present);
 
-			// Idle until the next frame. Sleep until within 1.5 ms, then yield until within 0.1 ms, then busy-wait.
+			// Idle until the next frame deadline, sleeping on a high-resolution timer and only spinning for the last moments
+			allocations::SetFramePhase(FramePhase::Idle);
 			idleTimer.Restart();
-			if (m_targetFramesPerSecond > 0)
+			m_framePacer.SetTargetFramesPerSecond(m_pacedFramesPerSecond);
+			m_framePacer.WaitForNextFrame();
+			if (m_renderMode == RenderMode::OnDemand)
 			{
-				auto targetFrameTime = std::chrono::microseconds(static_cast<int>(1.f / m_targetFramesPerSecond * 1'000'000));
-				while (targetFrameTime > frameTimer.ElapsedDuration())
-				{
-					auto remainingTime = targetFrameTime - frameTimer.ElapsedMilliseconds();
-					constexpr auto spinThreshold = 1.5ms;
-					constexpr auto yieldThreshold = 0.1ms;
-					if (remainingTime > spinThreshold)
-					{
-						std::this_thread::sleep_for(remainingTime - spinThreshold);
-					}
-					else if (remainingTime > yieldThreshold)
-					{
-						std::this_thread::yield();
-					}
-				}
+				WaitForRedraw(eventStream);
 			}
 			idleTimer.Stop();
 			frameTimer.Stop();
+			RecordHardwareCounts(FramePhase::Idle);
 
 			m_lastFrameTimings.totalFrameTime = frameTimer.ElapsedSeconds();
-			m_lastFrameTimings.tickTime = tickTimer.ElapsedSeconds();
+			m_lastFrameTimings.tickTime = isTickPipelined ? m_pipelinedTickTime : tickTimer.ElapsedSeconds();
 			m_lastFrameTimings.renderTime = renderTimer.ElapsedSeconds();
 			m_lastFrameTimings.presentTime = presentTimer.ElapsedSeconds();
 			m_lastFrameTimings.idleTime = idleTimer.ElapsedSeconds();
+			m_lastFrameTimings.wakeError = m_framePacer.GetLastWakeError();
+			m_lastFrameTimings.deadlineMiss = m_framePacer.GetLastDeadlineMiss();
+			m_lastFrameTimings.isRenderSkipped = frameSkip == FrameSkip::RenderAndPresent;
+			m_lastFrameTimings.isPresentSkipped = frameSkip != FrameSkip::None;
+			m_lastFrameTimings.present = frameSkip == FrameSkip::None ? renderer.GetLastPresentStatistics() : PresentStatistics{};
+			m_lastFrameTimings.terminalRoundTrip = m_isTerminalPacingEnabled ? m_terminalRoundTrip : std::chrono::duration<double>::zero();
+			m_lastFrameTimings.pacedFramesPerSecond = m_pacedFramesPerSecond;
+
+			// A pipelined tick is counted on the simulation thread; the main thread only signalled it
+			m_lastFrameTimings.hardwareCounts = m_frameHardwareCounts;
+			if (isTickPipelined)
+			{
+				m_lastFrameTimings.hardwareCounts[static_cast<size_t>(FramePhase::Tick)] = m_pipelinedTickHardwareCounts;
+			}
+			m_frameHardwareCounts.fill({});
+
+			RecordTimingStatistics();
+
+			const auto allocationSnapshot = allocations::GetSnapshot();
+			for (size_t i = 0; i < framePhaseCount; ++i)
+			{
+				m_lastFrameTimings.allocations[i].allocations = allocationSnapshot.phases[i].allocations - m_lastAllocationSnapshot.phases[i].allocations;
+				m_lastFrameTimings.allocations[i].bytes = allocationSnapshot.phases[i].bytes - m_lastAllocationSnapshot.phases[i].bytes;
+			}
+			m_lastFrameTimings.liveHeapBytes = allocationSnapshot.liveBytes;
+			m_lastFrameTimings.peakLiveHeapBytes = allocationSnapshot.peakLiveBytes;
+			m_lastAllocationSnapshot = allocationSnapshot;
+
+			m_telemetry.RecordFrame(m_lastFrameTimings);
+
+			if (m_lastFrameTimings.inputEventsConsumed > 0)
+			{
+				m_lastInputFrameTimings = m_lastFrameTimings;
+			}
+
+			m_frameArena.Reset();
 		}
 
+		allocations::SetFramePhase(FramePhase::Other);
+		StopTickThread();
+		m_telemetry.Stop();
+
 		game.EndPlay();
 		game.SetEngine(nullptr);
 		m_game = nullptr;
 
+		eventStream.StopInputThread();
 		eventStream.UnregisterWindowResizeConsumer(this);
 		eventStream.UnregisterKeyboardInputConsumer(this);
+		eventStream.SetLineCompletionHandler(nullptr);
+		m_eventStream = nullptr;
+		m_renderer = nullptr;
 
 		// Reset the timer precision to the default
 		::timeEndPeriod(1);
@@ -209,6 +341,10 @@ namespace engine
 	void Engine::StopGame()
 	{
 		m_shouldStopGame = true;
+		if (m_eventStream != nullptr)
+		{
+			m_eventStream->Wake();
+		}
 	}
 
 	void Engine::OnWindowResize(uint16_t x, uint16_t y)
@@ -250,25 +386,916 @@ namespace engine
 			return true;
 		}
 
-		if (line == u8"quit" || line == u8"exit")
+		if (m_commands.Execute(line, m_commanderOutput))
 		{
-			StopGame();
 			return true;
 		}
 
-		if (line == u8"fps")
+		if (!line.empty())
 		{
-			m_showFps = !m_showFps;
-			return true;
+			m_commanderOutput = u8"Unknown command: " + line;
+		}
+		return false;
+	}
+
+	uint16_t Engine::TickGame(std::chrono::duration<double> deltaTime)
+	{
+		NU_PROFILE_SCOPE("Tick");
+
+		if (m_fixedTicksPerSecond == 0)
+		{
+			m_game->Tick(deltaTime);
+			m_interpolationAlpha = 1.0;
+			return 1;
+		}
+
+		const auto fixedDeltaTime = std::chrono::duration<double>(1.0 / m_fixedTicksPerSecond);
+		m_tickAccumulator += deltaTime;
+
+		uint16_t ticks = 0;
+		while (m_tickAccumulator >= fixedDeltaTime && ticks < m_maxTicksPerFrame)
+		{
+			m_game->Tick(fixedDeltaTime);
+			m_tickAccumulator -= fixedDeltaTime;
+			++ticks;
+		}
+
+		// Drop whole ticks that couldn't be caught up on, keeping the fractional remainder for interpolation
+		if (m_tickAccumulator >= fixedDeltaTime)
+		{
+			m_tickAccumulator = std::chrono::duration<double>(std::fmod(m_tickAccumulator.count(), fixedDeltaTime.count()));
+		}
+
+		m_interpolationAlpha = m_tickAccumulator / fixedDeltaTime;
+		return ticks;
+	}
+
+	void Engine::RequestRedraw()
+	{
+		m_isRedrawRequested.store(true, std::memory_order_release);
+		if (m_eventStream != nullptr)
+		{
+			m_eventStream->Wake();
+		}
+	}
+
+	void Engine::RequestRedrawAfter(std::chrono::duration<double> delay)
+	{
+		const auto redrawTime = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay);
+		m_nextTimedRedraw = std::min(m_nextTimedRedraw, redrawTime);
+	}
+
+	void Engine::WaitForRedraw(ConsoleEventStream& eventStream)
+	{
+		NU_PROFILE_SCOPE("WaitForRedraw");
+
+		// Anything that ends the wait runs a frame, which processes whatever input or resize woke the engine
+		while (!m_shouldStopGame && m_renderMode == RenderMode::OnDemand)
+		{
+			if (m_isRedrawRequested.exchange(false, std::memory_order_acq_rel))
+			{
+				return;
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			if (now >= m_nextTimedRedraw)
+			{
+				m_nextTimedRedraw = std::chrono::steady_clock::time_point::max();
+				return;
+			}
+
+			if (eventStream.WaitForEvents(m_nextTimedRedraw - now))
+			{
+				m_isRedrawRequested.store(false, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	void Engine::UpdateTerminalPacing(ConsoleEventStream& eventStream, ConsoleRenderer& renderer)
+	{
+		// Requests are spaced out so their replies are a negligible share of input. One that goes unanswered for a while
+		// is no longer timed and another is sent; a terminal that leaves several unanswered doesn't support them.
+		constexpr auto probeInterval = 250ms;
+		constexpr auto probeTimeout = 1s;
+		constexpr size_t maxPendingProbes = 4;
+
+		// Weight of each new round trip in the smoothed one; low enough that one slow frame doesn't throttle presents
+		constexpr double smoothing = 0.2;
+
+		const std::chrono::duration<double> roundTrip = eventStream.TakeStatusReportRoundTrip();
+		if (roundTrip > 0s)
+		{
+			m_terminalRoundTrip = m_terminalRoundTrip > 0s ? m_terminalRoundTrip + (roundTrip - m_terminalRoundTrip) * smoothing : roundTrip;
+		}
+
+		// Replies to requests already written are still consumed, but no longer timed
+		if (!m_isTerminalPacingEnabled || m_isTerminalUnanswering)
+		{
+			m_terminalRoundTrip = std::chrono::duration<double>::zero();
+			renderer.CancelStatusReport();
+			eventStream.CancelStatusReports();
+			return;
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		const auto sinceLastProbe = now - m_lastTerminalProbeTime;
+		const size_t pendingProbes = eventStream.GetPendingStatusReportCount();
+		if (pendingProbes == 0 ? sinceLastProbe < probeInterval : sinceLastProbe < probeTimeout)
+		{
+			return;
+		}
+
+		if (pendingProbes > 0)
+		{
+			eventStream.CancelStatusReports();
+			if (pendingProbes >= maxPendingProbes)
+			{
+				m_isTerminalUnanswering = true;
+				return;
+			}
+		}
+
+		renderer.RequestStatusReport();
+		m_lastTerminalProbeTime = now;
+	}
+
+	bool Engine::IsPresentAheadOfTerminal()
+	{
+		if (!m_isTerminalPacingEnabled || m_terminalRoundTrip <= 0s)
+		{
+			return false;
+		}
+
+		// Presenting at most once per round trip keeps at most about one frame in flight to the terminal
+		const std::chrono::duration<double> sinceLastPresent = std::chrono::steady_clock::now() - m_lastPresentTime;
+		if (sinceLastPresent >= m_terminalRoundTrip)
+		{
+			return false;
+		}
+
+		if (m_renderMode == RenderMode::OnDemand)
+		{
+			RequestRedrawAfter(m_terminalRoundTrip - sinceLastPresent);
+		}
+		return true;
+	}
+
+	Engine::FrameSkip Engine::ApplyOverloadPolicy()
+	{
+		// Frames run over when their work, everything but idling, takes longer than the frame time being paced to
+		const auto workTime = m_lastFrameTimings.totalFrameTime - m_lastFrameTimings.idleTime;
+		if (m_overloadPolicy != OverloadPolicy::ReduceFrameRate || m_targetFramesPerSecond == 0)
+		{
+			m_pacedFramesPerSecond = m_targetFramesPerSecond;
+			m_overloadedFrames = 0;
+			m_underloadedFrames = 0;
+		}
+
+		switch (m_overloadPolicy)
+		{
+			case OverloadPolicy::SkipPresent:
+			case OverloadPolicy::SkipRenderAndPresent:
+			{
+				const bool isOverloaded = m_targetFramesPerSecond > 0 && workTime.count() * m_targetFramesPerSecond > 1.0;
+				if (!isOverloaded || m_consecutiveSkippedFrames >= m_maxSkippedFrames)
+				{
+					m_consecutiveSkippedFrames = 0;
+					return FrameSkip::None;
+				}
+
+				// A short skipped frame lets the frame pacer catch up with the schedule
+				++m_consecutiveSkippedFrames;
+				return m_overloadPolicy == OverloadPolicy::SkipPresent ? FrameSkip::Present : FrameSkip::RenderAndPresent;
+			}
+			case OverloadPolicy::ReduceFrameRate:
+			{
+				if (m_targetFramesPerSecond == 0)
+				{
+					break;
+				}
+
+				// Number of frames in a row that must run over before reducing, and fit comfortably before raising the frame rate.
+				// Raising only once work fits well within the higher rate's frame time keeps the rate from oscillating.
+				constexpr uint16_t framesBeforeReducing = 5;
+				constexpr uint16_t framesBeforeRaising = 60;
+				constexpr double raiseHeadroom = 0.8;
+				constexpr uint16_t minFramesPerSecond = 10;
+
+				m_pacedFramesPerSecond = std::clamp(m_pacedFramesPerSecond, std::min(minFramesPerSecond, m_targetFramesPerSecond), m_targetFramesPerSecond);
+				const auto raisedFramesPerSecond = static_cast<uint16_t>(std::min<int>(m_pacedFramesPerSecond * 5 / 4 + 1, m_targetFramesPerSecond));
+				if (workTime.count() * m_pacedFramesPerSecond > 1.0)
+				{
+					m_underloadedFrames = 0;
+					if (++m_overloadedFrames >= framesBeforeReducing)
+					{
+						// Drop to the rate the work currently allows, but by at least a quarter
+						const auto sustainableFramesPerSecond = static_cast<int>(1.0 / workTime.count());
+						m_pacedFramesPerSecond = static_cast<uint16_t>(
+							std::max<int>(std::min(m_pacedFramesPerSecond * 3 / 4, sustainableFramesPerSecond), minFramesPerSecond));
+						m_overloadedFrames = 0;
+					}
+				}
+				else if (m_pacedFramesPerSecond < m_targetFramesPerSecond && workTime.count() * raisedFramesPerSecond < raiseHeadroom)
+				{
+					m_overloadedFrames = 0;
+					if (++m_underloadedFrames >= framesBeforeRaising)
+					{
+						m_pacedFramesPerSecond = raisedFramesPerSecond;
+						m_underloadedFrames = 0;
+					}
+				}
+				else
+				{
+					m_overloadedFrames = 0;
+					m_underloadedFrames = 0;
+				}
+				break;
+			}
+			case OverloadPolicy::None:
+			default:
+				break;
+		}
+
+		m_consecutiveSkippedFrames = 0;
+		return FrameSkip::None;
+	}
+
+	void Engine::RecordTimingStatistics()
+	{
+		// Paced frames land within a few percent of the target frame time, so only frames well past it count as misses
+		constexpr double frameBudgetTolerance = 1.1;
+		const auto budget = m_targetFramesPerSecond > 0
+			? std::chrono::duration<double>(1.0 / m_targetFramesPerSecond)
+			: std::chrono::duration<double>::zero();
+		for (size_t i = 0; i < m_timingWindows.size(); ++i)
+		{
+			m_timingWindows[i].SetBudget(i == static_cast<size_t>(TimingBucket::Frame) ? budget * frameBudgetTolerance : budget);
+		}
+
+		m_timingWindows[static_cast<size_t>(TimingBucket::Frame)].AddSample(m_lastFrameTimings.totalFrameTime);
+		m_timingWindows[static_cast<size_t>(TimingBucket::Tick)].AddSample(m_lastFrameTimings.tickTime);
+		if (!m_lastFrameTimings.isRenderSkipped)
+		{
+			m_timingWindows[static_cast<size_t>(TimingBucket::Render)].AddSample(m_lastFrameTimings.renderTime);
+		}
+		if (!m_lastFrameTimings.isPresentSkipped)
+		{
+			m_timingWindows[static_cast<size_t>(TimingBucket::Present)].AddSample(m_lastFrameTimings.presentTime);
+		}
+		m_timingWindows[static_cast<size_t>(TimingBucket::Idle)].AddSample(m_lastFrameTimings.idleTime);
+	}
+
+	void Engine::StartTickThread()
+	{
+		if (!m_tickThread.joinable())
+		{
+			m_tickThread = std::jthread([this](std::stop_token stopToken) { RunTickThread(stopToken); });
+		}
+	}
+
+	void Engine::StopTickThread()
+	{
+		if (m_tickThread.joinable())
+		{
+			// Wake the thread so it sees the stop request
+			m_tickThread.request_stop();
+			m_tickRequested.release();
+			m_tickThread.join();
+		}
+	}
+
+	void Engine::RunTickThread(std::stop_token stopToken)
+	{
+		allocations::SetThreadFramePhase(FramePhase::Tick);
+		profiler::SetThreadName("Simulation");
+
+		Stopwatch tickTimer;
+		while (true)
+		{
+			m_tickRequested.acquire();
+			if (stopToken.stop_requested())
+			{
+				return;
+			}
+
+			m_tickArena.Reset();
+			const bool areHardwareCountersEnabled = m_areHardwareCountersEnabled;
+			const auto startHardwareCounts = areHardwareCountersEnabled ? hardwareCounters::Read() : HardwareCounts{};
+			tickTimer.Restart();
+			m_pipelinedTicks = TickGame(m_pipelinedDeltaTime);
+			tickTimer.Stop();
+			m_pipelinedTickTime = tickTimer.ElapsedSeconds();
+			m_pipelinedTickHardwareCounts = areHardwareCountersEnabled ? hardwareCounters::Read() - startHardwareCounts : HardwareCounts{};
+
+			m_tickCompleted.release();
 		}
+	}
 
-		if (line == u8"stats" || line == u8"timings")
+	void Engine::RegisterCommands()
+	{
+		auto quit = [this](std::span<const std::u8string_view>)
+		{
+			StopGame();
+			return std::u8string();
+		};
+		m_commands.RegisterCommand(u8"quit", u8"Stops the game", quit);
+		m_commands.RegisterCommand(u8"exit", u8"Stops the game", quit);
+
+		m_commands.RegisterCommand(
+			u8"help",
+			u8"Lists commands and variables",
+			[this](std::span<const std::u8string_view>) { return m_commands.GetHelp(); });
+
+		m_commands.RegisterCommand(
+			u8"fps",
+			u8"Toggles the FPS counter",
+			[this](std::span<const std::u8string_view>)
+			{
+				m_showFps = !m_showFps;
+				return std::u8string();
+			});
+
+		auto toggleStats = [this](std::span<const std::u8string_view>)
 		{
 			m_showFrameTimings = !m_showFrameTimings;
-			return true;
+			if (m_renderer != nullptr)
+			{
+				m_renderer->SetCellStatisticsEnabled(m_showFrameTimings);
+			}
+			return std::u8string();
+		};
+		m_commands.RegisterCommand(u8"stats", u8"Toggles the frame timings overlay", toggleStats);
+		m_commands.RegisterCommand(u8"timings", u8"Toggles the frame timings overlay", toggleStats);
+
+		m_commands.RegisterCommand(
+			u8"heatmap",
+			u8"Tints cells by draws per frame or by recent console writes: heatmap [overdraw|changes|off]; cycles without an argument",
+			[this](std::span<const std::u8string_view> arguments)
+			{
+				if (m_renderer == nullptr)
+				{
+					return std::u8string();
+				}
+
+				auto heatmapMode = m_renderer->GetHeatmapMode();
+				if (arguments.empty())
+				{
+					heatmapMode = heatmapMode == HeatmapMode::None ? HeatmapMode::Overdraw
+					            : heatmapMode == HeatmapMode::Overdraw ? HeatmapMode::Changes
+					            : HeatmapMode::None;
+				}
+				else if (arguments.front() == u8"overdraw")
+				{
+					heatmapMode = HeatmapMode::Overdraw;
+				}
+				else if (arguments.front() == u8"changes")
+				{
+					heatmapMode = HeatmapMode::Changes;
+				}
+				else if (arguments.front() == u8"off")
+				{
+					heatmapMode = HeatmapMode::None;
+				}
+				else
+				{
+					return details::ToU8String(std::format("Unknown heatmap {}", details::AsCharView(arguments.front())));
+				}
+
+				m_renderer->SetHeatmapMode(heatmapMode);
+				switch (heatmapMode)
+				{
+					case HeatmapMode::Overdraw:
+						return u8"Overdraw: green drawn once, yellow twice, red three or more times"s;
+					case HeatmapMode::Changes:
+						return u8"Changes: red written to the console this frame, fading through yellow and green"s;
+					case HeatmapMode::None:
+					default:
+						return u8"Heatmap off"s;
+				}
+			});
+
+		m_commands.RegisterCommand(
+			u8"profiler",
+			u8"Toggles the profiler's flame bars, recording profile scopes while they're shown",
+			[this](std::span<const std::u8string_view>)
+			{
+				m_showProfiler = !m_showProfiler;
+				profiler::SetEnabled(m_showProfiler);
+				return std::u8string();
+			});
+
+		m_commands.RegisterCommand(
+			u8"profile_export",
+			u8"Writes recently recorded profile scopes as Chrome trace JSON: profile_export [path]",
+			[this](std::span<const std::u8string_view> arguments)
+			{
+				const auto path = arguments.empty() ? u8"profile.json"sv : arguments.front();
+				const int64_t eventCount = m_profileCapture.ExportChromeTrace(std::filesystem::path(path));
+				if (eventCount < 0)
+				{
+					return details::ToU8String(std::format("Failed to write {}", details::AsCharView(path)));
+				}
+				const uint64_t droppedEvents = m_profileCapture.GetDroppedEventCount();
+				if (droppedEvents > 0)
+				{
+					return details::ToU8String(std::format(
+						"Wrote {} events to {}; {} events were dropped since start because profile rings were full",
+						eventCount,
+						details::AsCharView(path),
+						droppedEvents));
+				}
+				return details::ToU8String(std::format("Wrote {} events to {}", eventCount, details::AsCharView(path)));
+			});
+
+		m_commands.RegisterCommand(
+			u8"clock",
+			u8"Shows the clock source frame timings and profile scopes are measured with",
+			[](std::span<const std::u8string_view>)
+			{
+				if (clock::IsTscAvailable())
+				{
+					return details::ToU8String(std::format("Invariant TSC at {:.3f} GHz", clock::GetTicksPerSecond(ClockSource::Tsc) / 1e9));
+				}
+				return u8"Steady clock; the CPU has no invariant TSC"s;
+			});
+
+		m_commands.RegisterVariable<bool>(
+			u8"profiling",
+			u8"Records profile scopes for profile_export",
+			std::function<bool()>([]() { return profiler::IsEnabled(); }),
+			std::function<void(const bool&)>([](const bool& value) { profiler::SetEnabled(value); }));
+
+		m_commands.RegisterVariable<bool>(
+			u8"telemetry",
+			u8"Records every frame's timings to CSV files in telemetry_directory",
+			std::function<bool()>([this]() { return m_telemetry.IsRunning(); }),
+			std::function<void(const bool&)>(
+				[this](const bool& value)
+				{
+					// Stays false if the directory can't be created
+					if (value)
+					{
+						m_telemetry.Start(m_telemetryDirectory);
+					}
+					else
+					{
+						m_telemetry.Stop();
+					}
+				}));
+
+		m_commands.RegisterVariable<std::string>(u8"telemetry_directory", u8"Directory telemetry files are written to", m_telemetryDirectory);
+
+		m_commands.RegisterVariable<uint16_t>(u8"target_fps", u8"Target frames per second; 0 is unlimited", m_targetFramesPerSecond);
+
+		m_commands.RegisterVariable<uint16_t>(
+			u8"tick_rate",
+			u8"Fixed simulation ticks per second; 0 ticks once per frame",
+			std::function<uint16_t()>([this]() { return m_fixedTicksPerSecond; }),
+			std::function<void(const uint16_t&)>([this](const uint16_t& value) { SetFixedTicksPerSecond(value); }));
+
+		m_commands.RegisterVariable<uint16_t>(
+			u8"max_ticks_per_frame",
+			u8"Maximum fixed simulation ticks run in one frame",
+			std::function<uint16_t()>([this]() { return m_maxTicksPerFrame; }),
+			std::function<void(const uint16_t&)>([this](const uint16_t& value) { SetMaxTicksPerFrame(value); }));
+
+		m_commands.RegisterVariable<bool>(
+			u8"input_thread",
+			u8"Reads console input on a dedicated thread",
+			std::function<bool()>([this]() { return m_isInputThreadEnabled; }),
+			std::function<void(const bool&)>([this](const bool& value) { SetInputThreadEnabled(value); }));
+
+		m_commands.RegisterVariable<bool>(
+			u8"hardware_counters",
+			u8"Counts CPU cycles and page faults per frame phase, shown with the frame timings",
+			std::function<bool()>([this]() { return m_areHardwareCountersEnabled; }),
+			std::function<void(const bool&)>([this](const bool& value) { SetHardwareCountersEnabled(value); }));
+
+		m_commands.RegisterVariable<bool>(u8"pipelined_tick", u8"Runs Tick on a simulation thread concurrently with Render", m_isPipelinedTickEnabled);
+
+		m_commands.RegisterVariable<std::string>(
+			u8"overload_policy",
+			u8"What to do when frames run over: none, skip_present, skip_render or reduce_fps",
+			std::function<std::string()>(
+				[this]()
+				{
+					switch (m_overloadPolicy)
+					{
+						case OverloadPolicy::SkipPresent:
+							return "skip_present"s;
+						case OverloadPolicy::SkipRenderAndPresent:
+							return "skip_render"s;
+						case OverloadPolicy::ReduceFrameRate:
+							return "reduce_fps"s;
+						case OverloadPolicy::None:
+						default:
+							return "none"s;
+					}
+				}),
+			std::function<bool(const std::string&)>(
+				[this](const std::string& value)
+				{
+					if (value == "none")
+					{
+						SetOverloadPolicy(OverloadPolicy::None);
+					}
+					else if (value == "skip_present")
+					{
+						SetOverloadPolicy(OverloadPolicy::SkipPresent);
+					}
+					else if (value == "skip_render")
+					{
+						SetOverloadPolicy(OverloadPolicy::SkipRenderAndPresent);
+					}
+					else if (value == "reduce_fps")
+					{
+						SetOverloadPolicy(OverloadPolicy::ReduceFrameRate);
+					}
+					else
+					{
+						return false;
+					}
+					return true;
+				}));
+
+		m_commands.RegisterVariable<uint16_t>(
+			u8"max_skipped_frames",
+			u8"Frames in a row the skip overload policies may skip",
+			std::function<uint16_t()>([this]() { return m_maxSkippedFrames; }),
+			std::function<void(const uint16_t&)>([this](const uint16_t& value) { SetMaxSkippedFrames(value); }));
+
+		m_commands.RegisterVariable<bool>(
+			u8"on_demand_rendering",
+			u8"Runs frames only after input, resizes or redraw requests",
+			std::function<bool()>([this]() { return m_renderMode == RenderMode::OnDemand; }),
+			std::function<void(const bool&)>([this](const bool& value) { SetRenderMode(value ? RenderMode::OnDemand : RenderMode::Continuous); }));
+
+		m_commands.RegisterVariable<bool>(u8"late_latch_input", u8"Processes input again right before Render", m_isLateLatchInputEnabled);
+
+		m_commands.RegisterVariable<bool>(u8"key_callbacks", u8"Dispatches OnKeyDown/OnKeyUp to the game", m_areKeyCallbacksEnabled);
+
+		m_commands.RegisterVariable<bool>(
+			u8"async_present",
+			u8"Writes to the console on an output thread, dropping frames while the console is behind",
+			std::function<bool()>([this]() { return m_renderer != nullptr && m_renderer->IsAsyncPresentEnabled(); }),
+			std::function<void(const bool&)>(
+				[this](const bool& value)
+				{
+					if (m_renderer != nullptr)
+					{
+						m_renderer->SetAsyncPresentEnabled(value);
+					}
+				}));
+
+		m_commands.RegisterVariable<bool>(
+			u8"terminal_pacing",
+			u8"Measures the terminal's round trip with cursor position requests and presents at most once per round trip",
+			std::function<bool()>([this]() { return m_isTerminalPacingEnabled; }),
+			std::function<void(const bool&)>([this](const bool& value) { SetTerminalPacingEnabled(value); }));
+
+		m_commands.RegisterVariable<bool>(
+			u8"incremental_drawing",
+			u8"Preserves draw calls across frames in the renderer",
+			std::function<bool()>([this]() { return m_renderer != nullptr && m_renderer->IsIncrementalDrawingEnabled(); }),
+			std::function<void(const bool&)>(
+				[this](const bool& value)
+				{
+					if (m_renderer != nullptr)
+					{
+						m_renderer->SetIncrementalDrawingEnabled(value);
+					}
+				}));
+	}
+
+	void Engine::DrawOverlays(ConsoleRenderer& renderer)
+	{
+		NU_PROFILE_SCOPE("DrawOverlays");
+
+		// Render the profiler's flame bars, if enabled
+		if (m_showProfiler)
+		{
+			m_profileCapture.DrawFlameBars(renderer, m_frameArena, static_cast<uint16_t>(m_renderSizeY / 3));
 		}
 
-		return false;
+		// Render FPS counter, if enabled
+		if (m_showFps)
+		{
+			int fps = static_cast<int>(std::round(1.f / m_lastFrameTimings.totalFrameTime.count()));
+			auto fpsString = m_frameArena.Format("{} FPS", fps);
+			int x = std::max(0, m_renderSizeX - static_cast<int>(fpsString.size()));
+
+			constexpr int yOffset = 3;
+			int y = std::max(0, m_renderSizeY / 4 - yOffset);
+
+			renderer.DrawString(x, y, fpsString, vt::color::ForegroundBrightCyan);
+		}
+
+		// Render frame timing stats, if enabled
+		if (m_showFrameTimings)
+		{
+			constexpr auto frameTimeLabel =   "Frame:   "sv;
+			constexpr auto tickTimeLabel =    "Tick:    "sv;
+			constexpr auto renderTimeLabel =  "Render:  "sv;
+			constexpr auto presentTimeLabel = "Present: "sv;
+			constexpr auto idleTimeLabel =    "Idle:    "sv;
+			constexpr auto inputLatencyLabel = "Input:   "sv;
+			constexpr auto wakeErrorLabel =   "Wake:    "sv;
+			constexpr auto cellsLabel =       "Cells:   "sv;
+			constexpr auto changedLabel =     "Changed: "sv;
+			constexpr auto outputLabel =      "Output:  "sv;
+			constexpr auto bytesLabel =       "Bytes:   "sv;
+			constexpr auto terminalLabel =    "Terminal:"sv;
+			constexpr auto labelLength = static_cast<uint16_t>(frameTimeLabel.size());
+
+			auto toMs = [](const auto& duration) { return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(duration).count(); };
+			auto frameTime = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastFrameTimings.totalFrameTime));
+			auto tickTime = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastFrameTimings.tickTime));
+			auto renderTime = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastFrameTimings.renderTime));
+			auto presentTime = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastFrameTimings.presentTime));
+			auto idleTime = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastFrameTimings.idleTime));
+			auto inputLatency = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastInputFrameTimings.inputLatencyMax));
+			auto wakeError = m_frameArena.Format("{:>5.2f}ms", toMs(m_lastFrameTimings.wakeError));
+
+			// Rolling statistics go to the right of the last frame's timings, under a header
+			constexpr auto statisticsHeader = "   p50    p95    p99    max jitter miss"sv;
+			auto formatStatistics = [this, &toMs](TimingBucket bucket)
+			{
+				const auto statistics = GetTimingStatistics(bucket);
+				return m_frameArena.Format(
+					"{:>6.2f} {:>6.2f} {:>6.2f} {:>6.2f} {:>6.2f} {:>4}",
+					toMs(statistics.p50),
+					toMs(statistics.p95),
+					toMs(statistics.p99),
+					toMs(statistics.max),
+					toMs(statistics.jitter),
+					statistics.budgetMisses);
+			};
+
+			int timingLength = static_cast<int>(
+				std::max({ frameTime.size(), tickTime.size(), renderTime.size(), presentTime.size(), idleTime.size(), inputLatency.size(), wakeError.size() }));
+			const int statisticsX = labelLength + timingLength + 1;
+			int x = std::max(0, m_renderSizeX - statisticsX - static_cast<int>(statisticsHeader.size()));
+
+			// Leave a row for the header between the FPS counter and the timings
+			constexpr int yOffset = 1;
+			int y = std::max(1, m_renderSizeY / 4 - yOffset);
+
+			renderer.DrawString(x + statisticsX, y - 1, statisticsHeader);
+			for (int i = 0; i < static_cast<int>(TimingBucket::Count); ++i)
+			{
+				renderer.DrawString(x + statisticsX, y + i, formatStatistics(static_cast<TimingBucket>(i)), vt::color::ForegroundWhite);
+			}
+
+			const int frameRowY = y;
+			renderer.DrawString(x, y, frameTimeLabel);
+			renderer.DrawString(x + labelLength, y, frameTime, vt::color::ForegroundBrightWhite);
+
+			auto tickColor = tickTime >= renderTime && tickTime >= presentTime ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite;
+			renderer.DrawString(x, ++y, tickTimeLabel);
+			renderer.DrawString(x + labelLength, y, tickTime, tickColor);
+
+			auto renderColor = renderTime >= tickTime && renderTime >= presentTime ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite;
+			renderer.DrawString(x, ++y, renderTimeLabel);
+			renderer.DrawString(x + labelLength, y, renderTime, renderColor);
+
+			auto presentColor = presentTime >= tickTime && presentTime >= renderTime ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite;
+			renderer.DrawString(x, ++y, presentTimeLabel);
+			renderer.DrawString(x + labelLength, y, presentTime, presentColor);
+
+			renderer.DrawString(x, ++y, idleTimeLabel);
+			renderer.DrawString(x + labelLength, y, idleTime, vt::color::ForegroundBrightWhite);
+
+			// Worst-case input-to-present latency of the most recent frame that consumed input
+			renderer.DrawString(x, ++y, inputLatencyLabel);
+			renderer.DrawString(x + labelLength, y, inputLatency, vt::color::ForegroundBrightWhite);
+
+			// How late the frame pacer's timer woke; the pacer spins before each deadline to cover this
+			renderer.DrawString(x, ++y, wakeErrorLabel);
+			renderer.DrawString(x + labelLength, y, wakeError, vt::color::ForegroundBrightWhite);
+
+			// Cells the last frame drew and drew more than once; the overlays count toward them too
+			const auto& cellStatistics = renderer.GetLastCellStatistics();
+			renderer.DrawString(x, ++y, cellsLabel);
+			renderer.DrawString(
+				x + labelLength,
+				y,
+				m_frameArena.Format("{} drawn, {} overdrawn", cellStatistics.cellWrites, cellStatistics.overdrawnCells),
+				vt::color::ForegroundBrightWhite);
+
+			// What the last Present wrote to the console; a slow write of few bytes means the terminal is falling behind
+			const auto& presentStatistics = m_lastFrameTimings.present;
+			renderer.DrawString(x, ++y, changedLabel);
+			renderer.DrawString(
+				x + labelLength,
+				y,
+				m_frameArena.Format("{} cells in {} runs", presentStatistics.changedCells, presentStatistics.runs),
+				vt::color::ForegroundBrightWhite);
+
+			renderer.DrawString(x, ++y, outputLabel);
+			renderer.DrawString(
+				x + labelLength,
+				y,
+				presentStatistics.isCoalesced
+					? "dropped, console behind"sv
+					: m_frameArena.Format("{}B in {} writes, {:.2f}ms", presentStatistics.GetTotalBytes(), presentStatistics.writes, toMs(presentStatistics.writeTime)),
+				presentStatistics.isCoalesced ? vt::color::ForegroundBrightYellow : vt::color::ForegroundBrightWhite);
+
+			renderer.DrawString(x, ++y, bytesLabel);
+			renderer.DrawString(
+				x + labelLength,
+				y,
+				m_frameArena.Format("{} cursor, {} color, {} text", presentStatistics.cursorBytes, presentStatistics.colorBytes, presentStatistics.textBytes),
+				vt::color::ForegroundBrightWhite);
+
+			// Smoothed round trip that terminal pacing caps the present rate to
+			if (m_isTerminalPacingEnabled)
+			{
+				renderer.DrawString(x, ++y, terminalLabel);
+				renderer.DrawString(
+					x + labelLength,
+					y,
+					m_isTerminalUnanswering ? "no replies, not paced"sv
+					: m_terminalRoundTrip > 0s ? m_frameArena.Format("{:>5.2f}ms round trip", toMs(m_terminalRoundTrip))
+					: "no reply yet"sv,
+					vt::color::ForegroundBrightWhite);
+			}
+
+			// The heap totals take the row under the last overlay row when allocations are tracked
+			int lastRowY = y;
+			if constexpr (allocations::isTrackingEnabled)
+			{
+				lastRowY = DrawAllocationStats(renderer, x, frameRowY, y);
+			}
+
+			if (m_areHardwareCountersEnabled)
+			{
+				DrawHardwareCounterStats(renderer, x, lastRowY + 2);
+			}
+		}
+	}
+
+	int Engine::DrawAllocationStats(ConsoleRenderer& renderer, int timingsX, int timingsY, int lastRowY)
+	{
+		auto formatBytes = [this](uint64_t bytes)
+		{
+			if (bytes >= 1024 * 1024)
+			{
+				return m_frameArena.Format("{:.1f}MB", bytes / (1024.0 * 1024.0));
+			}
+			if (bytes >= 1024)
+			{
+				return m_frameArena.Format("{:.1f}KB", bytes / 1024.0);
+			}
+			return m_frameArena.Format("{}B", bytes);
+		};
+
+		const auto& phaseAllocations = m_lastFrameTimings.allocations;
+		AllocationCounts frameAllocations;
+		for (const auto& counts : phaseAllocations)
+		{
+			frameAllocations.allocations += counts.allocations;
+			frameAllocations.bytes += counts.bytes;
+		}
+
+		// Allocation count and size of each phase go left of the timing row they belong to; the frame row has the frame's total
+		const std::array rows = {
+			frameAllocations,
+			phaseAllocations[static_cast<size_t>(FramePhase::Tick)],
+			phaseAllocations[static_cast<size_t>(FramePhase::Render)],
+			phaseAllocations[static_cast<size_t>(FramePhase::Present)],
+			phaseAllocations[static_cast<size_t>(FramePhase::Idle)],
+			phaseAllocations[static_cast<size_t>(FramePhase::Input)],
+		};
+
+		constexpr int rowLength = 16;
+		const int x = std::max(0, timingsX - rowLength);
+		int y = timingsY;
+		for (const auto& counts : rows)
+		{
+			auto row = m_frameArena.Format("{:>6} {:>8}", counts.allocations, formatBytes(counts.bytes));
+			renderer.DrawString(x, y++, row, counts.allocations > 0 ? vt::color::ForegroundBrightYellow : vt::color::ForegroundWhite);
+		}
+
+		// Heap totals go below the overlay's last row
+		constexpr auto heapLabel = "Heap:    "sv;
+		const auto heapBytes = m_frameArena.Format(
+			"{} live, {} peak", formatBytes(m_lastFrameTimings.liveHeapBytes), formatBytes(m_lastFrameTimings.peakLiveHeapBytes));
+
+		const int heapX = std::max(0, m_renderSizeX - static_cast<int>(heapLabel.size() + heapBytes.size()));
+		const int heapY = lastRowY + 1;
+		renderer.DrawString(heapX, heapY, heapLabel);
+		renderer.DrawString(heapX + static_cast<int>(heapLabel.size()), heapY, heapBytes, vt::color::ForegroundBrightWhite);
+		return heapY;
+	}
+
+	void Engine::DrawHardwareCounterStats(ConsoleRenderer& renderer, int x, int y)
+	{
+		struct Row
+		{
+			std::string_view label;
+			FramePhase phase;
+			std::chrono::duration<double> time;
+		};
+
+		const std::array rows = {
+			Row{ "Tick:    "sv, FramePhase::Tick, m_lastFrameTimings.tickTime },
+			Row{ "Render:  "sv, FramePhase::Render, m_lastFrameTimings.renderTime },
+			Row{ "Present: "sv, FramePhase::Present, m_lastFrameTimings.presentTime },
+			Row{ "Idle:    "sv, FramePhase::Idle, m_lastFrameTimings.idleTime },
+		};
+		constexpr auto labelLength = 9;
+
+		// CPU is the share of the phase's time its thread ran; a slow phase with low CPU was blocked, e.g. on console output
+		renderer.DrawString(x + labelLength, y, "Mcycles   CPU faults"sv);
+		for (const auto& row : rows)
+		{
+			const auto& counts = m_lastFrameTimings.hardwareCounts[static_cast<size_t>(row.phase)];
+			const auto utilization = clock::IsTscAvailable()
+				? m_frameArena.Format("{:>4.0f}%", hardwareCounters::GetUtilization(counts, row.time.count()) * 100.0)
+				: "    -"sv;
+
+			renderer.DrawString(x, ++y, row.label);
+			renderer.DrawString(
+				x + labelLength,
+				y,
+				m_frameArena.Format("{:>7.2f} {} {:>6}", counts.cycles / 1'000'000.0, utilization, counts.pageFaults),
+				vt::color::ForegroundBrightWhite);
+		}
+	}
+
+	void Engine::RecordHardwareCounts(FramePhase endingPhase)
+	{
+		if (!m_areHardwareCountersEnabled)
+		{
+			return;
+		}
+
+		const auto counts = hardwareCounters::Read();
+		m_frameHardwareCounts[static_cast<size_t>(endingPhase)] += counts - m_lastHardwareCounts;
+		m_lastHardwareCounts = counts;
+	}
+
+	void Engine::DrawCommander(ConsoleRenderer& renderer, const ConsoleEventStream& eventStream)
+	{
+		for (uint16_t x = 0; x < m_renderSizeX; ++x)
+		{
+			renderer.DrawChar(x, m_renderSizeY - 1, ' ', vt::color::ForegroundBlack, vt::color::BackgroundBrightBlue);
+		}
+
+		// Draw both halves of the line editor directly, so the line is never copied while the commander is open
+		const auto& lineEditor = eventStream.GetLineEditor();
+		const uint16_t y = m_renderSizeY - 1;
+		const auto cursorX = static_cast<uint16_t>(std::min<size_t>(2 + lineEditor.GetCursorColumn(), m_renderSizeX));
+		renderer.DrawString(0, y, "> ", vt::color::ForegroundBrightWhite, vt::color::BackgroundBrightBlue);
+		renderer.DrawU8String(2, y, lineEditor.GetTextBeforeCursor(), vt::color::ForegroundBrightWhite, vt::color::BackgroundBrightBlue);
+		renderer.DrawU8String(cursorX, y, lineEditor.GetTextAfterCursor(), vt::color::ForegroundBrightWhite, vt::color::BackgroundBrightBlue);
+
+		const auto cursorCharacter = lineEditor.GetCodePointAtCursor();
+		renderer.DrawU8Char(cursorX, y, cursorCharacter.empty() ? u8" "sv : cursorCharacter, vt::color::ForegroundBlack, vt::color::BackgroundBrightWhite);
+
+		// Draw output from the last command above the commander, last line nearest the commander
+		std::u8string_view output = m_commanderOutput;
+		uint16_t outputY = y;
+		while (!output.empty() && outputY > 0)
+		{
+			const size_t lineStart = output.find_last_of(u8'\n');
+			const auto line = lineStart == std::u8string_view::npos ? output : output.substr(lineStart + 1);
+			output = lineStart == std::u8string_view::npos ? std::u8string_view() : output.substr(0, lineStart);
+
+			--outputY;
+			for (uint16_t x = 0; x < m_renderSizeX; ++x)
+			{
+				renderer.DrawChar(x, outputY, ' ', vt::color::ForegroundBlack, vt::color::BackgroundBlue);
+			}
+			renderer.DrawU8String(0, outputY, line, vt::color::ForegroundBrightWhite, vt::color::BackgroundBlue);
+		}
+	}
+
+	void Engine::SetInputThreadEnabled(bool enableInputThread)
+	{
+		m_isInputThreadEnabled = enableInputThread;
+		if (m_eventStream == nullptr)
+		{
+			return;
+		}
+
+		if (enableInputThread)
+		{
+			m_eventStream->StartInputThread();
+		}
+		else
+		{
+			m_eventStream->StopInputThread();
+		}
+	}
+
+	void Engine::SetHardwareCountersEnabled(bool enableHardwareCounters)
+	{
+		// Start counting from now, rather than from the last read before the counters were disabled
+		m_areHardwareCountersEnabled = enableHardwareCounters && hardwareCounters::IsAvailable();
+		m_lastHardwareCounts = hardwareCounters::Read();
+		m_frameHardwareCounts.fill({});
 	}
 
 	void Engine::SetDesiredRendererSize(uint16_t x, uint16_t y) noexcept
@@ -0,0 +1,31 @@
+#include "NuEngine/FrameArena.h"
+
+namespace nu
+{
+namespace engine
+{
+	FrameArena::FrameArena(size_t initialCapacity) : m_buffer(initialCapacity)
+	{
+		m_resource.emplace(m_buffer.data(), m_buffer.size(), &m_upstream);
+	}
+
+	void FrameArena::Reset()
+	{
+		if (m_upstream.allocatedBytes == 0)
+		{
+			m_resource->release();
+			return;
+		}
+
+		// Grow the buffer to hold everything allocated since the last Reset, with headroom so slowly growing frames
+		// don't reallocate every time
+		const size_t requiredCapacity = m_buffer.size() + m_upstream.allocatedBytes;
+		m_resource.reset();
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+		m_buffer.resize(requiredCapacity + requiredCapacity / 2);
+		m_upstream.allocatedBytes = 0;
+		m_resource.emplace(m_buffer.data(), m_buffer.size(), &m_upstream);
+	}
+} // namespace engine
+} // namespace nu
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "NuEngine/FramePacer.h"
+
+#include <algorithm>
+
+#include "NuEngine/Assertions.h"
+#include "NuEngine/Profiler.h"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include "Windows.h"
+
+using namespace std::chrono_literals;
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// Spin margin used until wake-up errors have been measured; generous enough for a 1ms timer resolution
+		constexpr auto initialSpinMargin = 1ms;
+
+		// Added to the worst recent wake-up error to absorb the occasional slightly later wake-up
+		constexpr auto spinMarginSafety = 50us;
+
+		// Bounds of the adaptive spin margin
+		constexpr auto minSpinMargin = 20us;
+		constexpr auto maxSpinMargin = 2ms;
+	} // namespace
+
+	FramePacer::FramePacer() : m_spinMargin(initialSpinMargin)
+	{
+		// High-resolution timers wake within tens of microseconds; they need Windows 10 1803, so fall back to a regular timer
+		m_hTimer = ::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (m_hTimer == nullptr)
+		{
+			m_hTimer = ::CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+		}
+		VerifyElseCrash(m_hTimer != nullptr);
+
+		m_wakeErrors.fill(std::chrono::duration_cast<Clock::duration>(initialSpinMargin));
+	}
+
+	FramePacer::~FramePacer()
+	{
+		::CloseHandle(m_hTimer);
+	}
+
+	void FramePacer::SetTargetFramesPerSecond(uint16_t targetFramesPerSecond) noexcept
+	{
+		const auto period = targetFramesPerSecond > 0
+			? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFramesPerSecond))
+			: Clock::duration::zero();
+		if (period == m_period)
+		{
+			return;
+		}
+
+		m_period = period;
+		m_deadline = Clock::now();
+	}
+
+	void FramePacer::WaitForNextFrame()
+	{
+		NU_PROFILE_SCOPE("WaitForNextFrame");
+
+		m_lastWakeError = std::chrono::duration<double>::zero();
+		m_lastDeadlineMiss = std::chrono::duration<double>::zero();
+		if (m_period == Clock::duration::zero())
+		{
+			return;
+		}
+
+		// Advance the absolute deadline; restart the sequence if the frame overran by more than a period
+		m_deadline += m_period;
+		auto now = Clock::now();
+		if (now >= m_deadline + m_period)
+		{
+			m_deadline = now;
+			return;
+		}
+
+		// Sleep until the spin margin before the deadline
+		const auto wakeTime = m_deadline - std::chrono::duration_cast<Clock::duration>(m_spinMargin);
+		if (wakeTime > now)
+		{
+			SleepUntil(wakeTime);
+			now = Clock::now();
+			RecordWakeError(now - wakeTime);
+		}
+
+		// Spin for the remainder
+		while (now < m_deadline)
+		{
+			::YieldProcessor();
+			now = Clock::now();
+		}
+
+		m_lastDeadlineMiss = now - m_deadline;
+	}
+
+	void FramePacer::SleepUntil(Clock::time_point wakeTime)
+	{
+		// Absolute due times are in system time, which can be adjusted, so the deadline is tracked on the steady clock and
+		// converted to a relative due time just before waiting. Negative due times are relative, in 100ns units.
+		const auto remaining = std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10'000'000>>>(wakeTime - Clock::now());
+		if (remaining.count() <= 0)
+		{
+			return;
+		}
+
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -remaining.count();
+		if (!::SetWaitableTimerEx(m_hTimer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+		{
+			return;
+		}
+
+		::WaitForSingleObject(m_hTimer, INFINITE);
+	}
+
+	void FramePacer::RecordWakeError(Clock::duration wakeError)
+	{
+		m_lastWakeError = wakeError;
+		m_wakeErrors[m_nextWakeErrorIndex] = wakeError;
+		m_nextWakeErrorIndex = (m_nextWakeErrorIndex + 1) % m_wakeErrors.size();
+
+		// Spin long enough to cover the worst recent wake-up, so the deadline is only missed when the timer does worse than it has lately
+		const auto worstWakeError = *std::ranges::max_element(m_wakeErrors);
+		m_spinMargin = std::clamp<std::chrono::duration<double>>(worstWakeError + spinMarginSafety, minSpinMargin, maxSpinMargin);
+	}
+} // namespace engine
+} // namespace nu
\ No newline at end of file
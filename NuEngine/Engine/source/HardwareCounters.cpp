@@ -0,0 +1,58 @@
+#include "NuEngine/HardwareCounters.h"
+
+#include <algorithm>
+
+#include "NuEngine/Clock.h"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include "Windows.h"
+#include "Psapi.h"
+
+namespace nu
+{
+namespace engine
+{
+	namespace hardwareCounters
+	{
+		bool IsAvailable()
+		{
+			static const bool isAvailable = []()
+			{
+				ULONG64 cycles = 0;
+				return QueryThreadCycleTime(GetCurrentThread(), &cycles) != FALSE;
+			}();
+			return isAvailable;
+		}
+
+		HardwareCounts Read() noexcept
+		{
+			HardwareCounts counts;
+
+			ULONG64 cycles = 0;
+			if (QueryThreadCycleTime(GetCurrentThread(), &cycles))
+			{
+				counts.cycles = cycles;
+			}
+
+			PROCESS_MEMORY_COUNTERS memoryCounters{};
+			if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+			{
+				counts.pageFaults = memoryCounters.PageFaultCount;
+			}
+
+			return counts;
+		}
+
+		double GetUtilization(const HardwareCounts& counts, double seconds)
+		{
+			// Thread cycle times count at the rate of the TSC, whatever the core's current frequency
+			if (seconds <= 0.0 || !clock::IsTscAvailable())
+			{
+				return 0.0;
+			}
+			return std::clamp(static_cast<double>(counts.cycles) / (seconds * clock::GetTicksPerSecond(ClockSource::Tsc)), 0.0, 1.0);
+		}
+	} // namespace hardwareCounters
+} // namespace engine
+} // namespace nu
@@ -0,0 +1,261 @@
+#include "NuEngine/JobSystem.h"
+
+#include <format>
+
+#include "NuEngine/Assertions.h"
+#include "NuEngine/Profiler.h"
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// Job system whose worker is running on this thread, if any
+		thread_local const JobSystem* t_workerJobSystem = nullptr;
+
+		// Index of the worker running on this thread
+		thread_local uint32_t t_workerIndex = 0;
+
+		// Scratch arena for jobs on this thread, created on first use
+		thread_local std::optional<FrameArena> t_jobArena;
+
+		// Number of jobs running on this thread, counting jobs run while waiting inside another job
+		thread_local uint32_t t_jobDepth = 0;
+
+		// Initial size of a job queue's ring buffer
+		constexpr size_t initialQueueCapacity = 64;
+	} // namespace
+
+	JobSystem::JobSystem(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		}
+
+		m_queueCount = workerCount + 1;
+		m_queues = std::make_unique<JobQueue[]>(m_queueCount);
+
+		m_workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i)
+		{
+			m_workers.emplace_back([this, i]() { RunWorker(i); });
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		// Wake all sleeping workers so they see the stop request; jobs still queued are dropped
+		m_isStopping.store(true, std::memory_order_release);
+		m_queuedJobs.fetch_add(1, std::memory_order_release);
+		m_queuedJobs.notify_all();
+		m_workers.clear();
+	}
+
+	void JobSystem::Submit(std::function<void()> job, JobCounter* counter)
+	{
+		if (counter != nullptr)
+		{
+			counter->m_pendingJobs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		Push(Job{ .function = std::move(job), .counter = counter });
+	}
+
+	void JobSystem::SubmitAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter)
+	{
+		if (counter != nullptr)
+		{
+			counter->m_pendingJobs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		{
+			std::lock_guard lock(dependency.m_continuationsMutex);
+			if (!dependency.IsComplete())
+			{
+				dependency.m_continuations.emplace_back(std::move(job), counter);
+				return;
+			}
+		}
+
+		Push(Job{ .function = std::move(job), .counter = counter });
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsComplete())
+		{
+			Job job;
+			if (TryTakeJob(job))
+			{
+				Execute(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		// The thread that completed the last job releases the counter's lock last; once it has, the counter may be destroyed
+		std::lock_guard lock(counter.m_continuationsMutex);
+	}
+
+	/*static*/ FrameArena& JobSystem::GetJobArena()
+	{
+		VerifyElseCrash(t_jobDepth > 0);
+		if (!t_jobArena.has_value())
+		{
+			t_jobArena.emplace();
+		}
+		return *t_jobArena;
+	}
+
+	void JobSystem::RunWorker(uint32_t workerIndex)
+	{
+		t_workerJobSystem = this;
+		t_workerIndex = workerIndex;
+		profiler::SetThreadName(std::format("Worker {}", workerIndex));
+
+		while (!m_isStopping.load(std::memory_order_acquire))
+		{
+			Job job;
+			if (TryTakeJob(job))
+			{
+				Execute(job);
+				continue;
+			}
+
+			// Sleep until a job is queued
+			m_queuedJobs.wait(0, std::memory_order_acquire);
+		}
+	}
+
+	void JobSystem::Push(Job&& job)
+	{
+		auto& queue = m_queues[GetQueueIndex()];
+		{
+			std::lock_guard lock(queue.mutex);
+			queue.PushBack(std::move(job));
+		}
+
+		m_queuedJobs.fetch_add(1, std::memory_order_release);
+		m_queuedJobs.notify_one();
+	}
+
+	bool JobSystem::TryTakeJob(Job& job)
+	{
+		// Take the most recently pushed job from the calling thread's own queue, as its data is most likely still in cache
+		const uint32_t queueIndex = GetQueueIndex();
+		{
+			auto& queue = m_queues[queueIndex];
+			std::lock_guard lock(queue.mutex);
+			if (queue.TryPopBack(job))
+			{
+				m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		// Steal the oldest job from another queue
+		for (uint32_t i = 1; i < m_queueCount; ++i)
+		{
+			auto& queue = m_queues[(queueIndex + i) % m_queueCount];
+			std::lock_guard lock(queue.mutex);
+			if (queue.TryPopFront(job))
+			{
+				m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::Execute(Job& job)
+	{
+		++t_jobDepth;
+		{
+			NU_PROFILE_SCOPE("Job");
+			job.function();
+		}
+		if (--t_jobDepth == 0 && t_jobArena.has_value())
+		{
+			t_jobArena->Reset();
+		}
+
+		if (job.counter != nullptr)
+		{
+			CompleteJob(*job.counter);
+		}
+	}
+
+	void JobSystem::CompleteJob(JobCounter& counter)
+	{
+		std::vector<JobCounter::Continuation> continuations;
+		{
+			// Decrement under the lock so Wait can't return, and the counter be destroyed, while it is still in use here
+			std::lock_guard lock(counter.m_continuationsMutex);
+			const uint32_t pendingJobs = counter.m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+			VerifyElseCrash(pendingJobs > 0);
+			if (pendingJobs == 1)
+			{
+				continuations.swap(counter.m_continuations);
+			}
+		}
+
+		for (auto& continuation : continuations)
+		{
+			Push(Job{ .function = std::move(continuation.function), .counter = continuation.counter });
+		}
+	}
+
+	void JobSystem::JobQueue::PushBack(Job&& job)
+	{
+		if (count == jobs.size())
+		{
+			// Unwrap the ring into a buffer twice the size
+			std::vector<Job> grownJobs(std::max(jobs.size() * 2, initialQueueCapacity));
+			for (size_t i = 0; i < count; ++i)
+			{
+				grownJobs[i] = std::move(jobs[(head + i) % jobs.size()]);
+			}
+			jobs = std::move(grownJobs);
+			head = 0;
+		}
+
+		jobs[(head + count) % jobs.size()] = std::move(job);
+		++count;
+	}
+
+	bool JobSystem::JobQueue::TryPopBack(Job& job)
+	{
+		if (count == 0)
+		{
+			return false;
+		}
+
+		--count;
+		job = std::move(jobs[(head + count) % jobs.size()]);
+		return true;
+	}
+
+	bool JobSystem::JobQueue::TryPopFront(Job& job)
+	{
+		if (count == 0)
+		{
+			return false;
+		}
+
+		job = std::move(jobs[head]);
+		head = (head + 1) % jobs.size();
+		--count;
+		return true;
+	}
+
+	uint32_t JobSystem::GetQueueIndex() const noexcept
+	{
+		return t_workerJobSystem == this ? t_workerIndex : m_queueCount - 1;
+	}
+} // namespace engine
+} // namespace nu
\ No newline at end of file
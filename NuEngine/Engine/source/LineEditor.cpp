@@ -0,0 +1,274 @@
+#include "NuEngine/LineEditor.h"
+
+#include <algorithm>
+#include <array>
+
+namespace nu
+{
+namespace console
+{
+	namespace
+	{
+		// Maximum number of committed lines kept in history
+		constexpr size_t maxHistorySize = 64;
+
+		// Minimum size of the gap buffer once allocated
+		constexpr size_t minBufferSize = 64;
+	} // namespace
+
+	void LineEditor::Insert(char32_t codePoint)
+	{
+		// Encode the code point as UTF-8
+		std::array<char8_t, 4> bytes;
+		size_t length = 0;
+		if (codePoint < 0x80)
+		{
+			bytes[length++] = static_cast<char8_t>(codePoint);
+		}
+		else if (codePoint < 0x800)
+		{
+			bytes[length++] = static_cast<char8_t>(0b11000000 | (codePoint >> 6));
+			bytes[length++] = static_cast<char8_t>(0b10000000 | (codePoint & 0b00111111));
+		}
+		else if (codePoint < 0x10000)
+		{
+			bytes[length++] = static_cast<char8_t>(0b11100000 | (codePoint >> 12));
+			bytes[length++] = static_cast<char8_t>(0b10000000 | ((codePoint >> 6) & 0b00111111));
+			bytes[length++] = static_cast<char8_t>(0b10000000 | (codePoint & 0b00111111));
+		}
+		else if (codePoint < 0x110000)
+		{
+			bytes[length++] = static_cast<char8_t>(0b11110000 | (codePoint >> 18));
+			bytes[length++] = static_cast<char8_t>(0b10000000 | ((codePoint >> 12) & 0b00111111));
+			bytes[length++] = static_cast<char8_t>(0b10000000 | ((codePoint >> 6) & 0b00111111));
+			bytes[length++] = static_cast<char8_t>(0b10000000 | (codePoint & 0b00111111));
+		}
+		else
+		{
+			// Not a valid code point
+			return;
+		}
+
+		ReserveGap(length);
+		std::copy_n(bytes.begin(), length, m_buffer.begin() + m_gapStart);
+		m_gapStart += length;
+		++m_cursorColumn;
+		m_isTextValid = false;
+	}
+
+	void LineEditor::Insert(std::u8string_view text)
+	{
+		ReserveGap(text.size());
+		std::ranges::copy(text, m_buffer.begin() + m_gapStart);
+		m_gapStart += text.size();
+		m_cursorColumn += std::ranges::count_if(text, [](char8_t byte) { return !IsContinuationByte(byte); });
+		m_isTextValid = false;
+	}
+
+	void LineEditor::Backspace()
+	{
+		if (m_gapStart == 0)
+		{
+			return;
+		}
+
+		do
+		{
+			--m_gapStart;
+		}
+		while (m_gapStart > 0 && IsContinuationByte(m_buffer[m_gapStart]));
+
+		--m_cursorColumn;
+		m_isTextValid = false;
+	}
+
+	void LineEditor::Delete()
+	{
+		if (m_gapEnd == m_buffer.size())
+		{
+			return;
+		}
+
+		m_gapEnd = std::min(m_gapEnd + GetSequenceLength(m_buffer[m_gapEnd]), m_buffer.size());
+		m_isTextValid = false;
+	}
+
+	void LineEditor::MoveLeft()
+	{
+		if (m_gapStart == 0)
+		{
+			return;
+		}
+
+		// Move the code point before the gap to the end of the gap
+		size_t start = m_gapStart - 1;
+		while (start > 0 && IsContinuationByte(m_buffer[start]))
+		{
+			--start;
+		}
+
+		const size_t length = m_gapStart - start;
+		std::copy_backward(m_buffer.begin() + start, m_buffer.begin() + m_gapStart, m_buffer.begin() + m_gapEnd);
+		m_gapStart -= length;
+		m_gapEnd -= length;
+		--m_cursorColumn;
+	}
+
+	void LineEditor::MoveRight()
+	{
+		if (m_gapEnd == m_buffer.size())
+		{
+			return;
+		}
+
+		// Move the code point after the gap to the start of the gap
+		const size_t length = std::min(GetSequenceLength(m_buffer[m_gapEnd]), m_buffer.size() - m_gapEnd);
+		std::copy_n(m_buffer.begin() + m_gapEnd, length, m_buffer.begin() + m_gapStart);
+		m_gapStart += length;
+		m_gapEnd += length;
+		++m_cursorColumn;
+	}
+
+	void LineEditor::MoveHome()
+	{
+		std::copy_backward(m_buffer.begin(), m_buffer.begin() + m_gapStart, m_buffer.begin() + m_gapEnd);
+		m_gapEnd -= m_gapStart;
+		m_gapStart = 0;
+		m_cursorColumn = 0;
+	}
+
+	void LineEditor::MoveEnd()
+	{
+		const auto textAfterCursor = GetTextAfterCursor();
+		m_cursorColumn += std::ranges::count_if(textAfterCursor, [](char8_t byte) { return !IsContinuationByte(byte); });
+
+		const size_t length = textAfterCursor.size();
+		std::copy(m_buffer.begin() + m_gapEnd, m_buffer.end(), m_buffer.begin() + m_gapStart);
+		m_gapStart += length;
+		m_gapEnd = m_buffer.size();
+	}
+
+	void LineEditor::HistoryPrevious()
+	{
+		if (m_historyIndex == 0)
+		{
+			return;
+		}
+
+		if (m_historyIndex == m_history.size())
+		{
+			m_draft = GetText();
+		}
+
+		--m_historyIndex;
+		SetText(m_history[m_historyIndex]);
+	}
+
+	void LineEditor::HistoryNext()
+	{
+		if (m_historyIndex >= m_history.size())
+		{
+			return;
+		}
+
+		++m_historyIndex;
+		SetText(m_historyIndex == m_history.size() ? m_draft : m_history[m_historyIndex]);
+	}
+
+	void LineEditor::SetText(std::u8string_view text)
+	{
+		// Keep the allocation; the text may be a view into the history
+		m_gapStart = 0;
+		m_gapEnd = m_buffer.size();
+		m_cursorColumn = 0;
+		Insert(text);
+	}
+
+	void LineEditor::Commit()
+	{
+		const auto& text = GetText();
+		if (!text.empty() && (m_history.empty() || m_history.back() != text))
+		{
+			if (m_history.size() == maxHistorySize)
+			{
+				m_history.erase(m_history.begin());
+			}
+			m_history.emplace_back(text);
+		}
+
+		Clear();
+	}
+
+	void LineEditor::Clear()
+	{
+		m_gapStart = 0;
+		m_gapEnd = m_buffer.size();
+		m_cursorColumn = 0;
+		m_historyIndex = m_history.size();
+		m_draft.clear();
+		m_isTextValid = false;
+	}
+
+	std::u8string_view LineEditor::GetCodePointAtCursor() const noexcept
+	{
+		const auto textAfterCursor = GetTextAfterCursor();
+		if (textAfterCursor.empty())
+		{
+			return textAfterCursor;
+		}
+
+		return textAfterCursor.substr(0, GetSequenceLength(textAfterCursor.front()));
+	}
+
+	const std::u8string& LineEditor::GetText()
+	{
+		if (!m_isTextValid)
+		{
+			m_text.assign(GetTextBeforeCursor());
+			m_text.append(GetTextAfterCursor());
+			m_isTextValid = true;
+		}
+
+		return m_text;
+	}
+
+	void LineEditor::ReserveGap(size_t bytes)
+	{
+		const size_t gapSize = m_gapEnd - m_gapStart;
+		if (gapSize >= bytes)
+		{
+			return;
+		}
+
+		// Grow geometrically so repeated inserts are amortized O(1), then move the text after the gap to the end
+		const size_t textAfterSize = m_buffer.size() - m_gapEnd;
+		const size_t newSize = std::max({ m_buffer.size() * 2, m_buffer.size() + bytes - gapSize, minBufferSize });
+		m_buffer.resize(newSize);
+		std::copy_backward(m_buffer.begin() + m_gapEnd, m_buffer.begin() + m_gapEnd + textAfterSize, m_buffer.end());
+		m_gapEnd = newSize - textAfterSize;
+	}
+
+	/*static*/ size_t LineEditor::GetSequenceLength(char8_t leadByte) noexcept
+	{
+		if ((leadByte & 0b10000000) == 0)
+		{
+			return 1;
+		}
+		if ((leadByte & 0b11100000) == 0b11000000)
+		{
+			return 2;
+		}
+		if ((leadByte & 0b11110000) == 0b11100000)
+		{
+			return 3;
+		}
+		if ((leadByte & 0b11111000) == 0b11110000)
+		{
+			return 4;
+		}
+
+		// Invalid lead byte; treat as a single byte
+		return 1;
+	}
+} // namespace console
+} // namespace nu
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "NuEngine/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "NuEngine/Clock.h"
+#include "NuEngine/ConsoleRenderer.h"
+#include "NuEngine/FrameArena.h"
+#include "NuEngine/SpscQueue.h"
+#include "NuEngine/VirtualTerminalSequences.h"
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// Events recorded by one thread, waiting to be collected
+		struct ThreadProfile
+		{
+			SpscQueue<ProfileEvent, 8192> events;
+			std::atomic<uint64_t> droppedEvents = 0;
+			std::string name;
+			uint16_t index = 0;
+
+			// Number of scopes currently open on the thread
+			uint16_t depth = 0;
+		};
+
+		// Every thread that recorded a scope or was named, in order; never removed, so indices stay valid
+		std::mutex g_threadsMutex;
+		std::vector<std::unique_ptr<ThreadProfile>> g_threads;
+
+		thread_local ThreadProfile* t_threadProfile = nullptr;
+
+		ThreadProfile& GetThreadProfile()
+		{
+			if (t_threadProfile == nullptr)
+			{
+				auto threadProfile = std::make_unique<ThreadProfile>();
+				std::lock_guard lock(g_threadsMutex);
+				threadProfile->index = static_cast<uint16_t>(g_threads.size());
+				t_threadProfile = g_threads.emplace_back(std::move(threadProfile)).get();
+			}
+			return *t_threadProfile;
+		}
+
+		// Every thread times scopes with the same clock source, so events of different threads line up
+		ClockSource GetClockSource()
+		{
+			static const ClockSource clockSource = clock::GetDefaultSource();
+			return clockSource;
+		}
+
+		int64_t Now() noexcept
+		{
+			return clock::Now(GetClockSource());
+		}
+
+		double TicksToMicroseconds(int64_t ticks)
+		{
+			return clock::ToDuration(ticks, GetClockSource()).count() * 1'000'000.0;
+		}
+
+		std::string_view GetThreadName(const ThreadProfile& threadProfile, FrameArena& arena)
+		{
+			return threadProfile.name.empty() ? arena.Format("Thread {}", threadProfile.index) : std::string_view(threadProfile.name);
+		}
+
+		void WriteJsonString(std::ostream& stream, std::string_view text)
+		{
+			stream << '"';
+			for (char c : text)
+			{
+				if (c == '"' || c == '\\')
+				{
+					stream << '\\';
+				}
+				stream << c;
+			}
+			stream << '"';
+		}
+	} // namespace
+
+	namespace profiler
+	{
+		void SetEnabled(bool isEnabled) noexcept
+		{
+			details::isEnabled.store(isEnabled, std::memory_order_relaxed);
+		}
+
+		void SetThreadName(std::string_view name)
+		{
+			auto& threadProfile = GetThreadProfile();
+			std::lock_guard lock(g_threadsMutex);
+			threadProfile.name = name;
+		}
+	} // namespace profiler
+
+	void ProfileScope::Begin(const char* name)
+	{
+		++GetThreadProfile().depth;
+		m_name = name;
+		m_start = Now();
+	}
+
+	void ProfileScope::End() noexcept
+	{
+		const int64_t end = Now();
+		auto& threadProfile = *t_threadProfile;
+		--threadProfile.depth;
+
+		const ProfileEvent event{ .name = m_name, .start = m_start, .end = end, .depth = threadProfile.depth, .threadIndex = threadProfile.index };
+		if (!threadProfile.events.TryPush(event))
+		{
+			threadProfile.droppedEvents.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void ProfileCapture::BeginFrame()
+	{
+		m_lastFrameStart = m_frameStart;
+		m_frameStart = Now();
+
+		if (profiler::IsEnabled() && m_history.empty())
+		{
+			m_history.resize(historyCapacity);
+			m_lastFrameEvents.reserve(4096);
+		}
+
+		m_lastFrameEvents.clear();
+		{
+			std::lock_guard lock(g_threadsMutex);
+			for (auto& threadProfile : g_threads)
+			{
+				ProfileEvent event;
+				while (threadProfile->events.TryPop(event))
+				{
+					m_lastFrameEvents.push_back(event);
+				}
+			}
+		}
+
+		if (!m_history.empty())
+		{
+			for (const auto& event : m_lastFrameEvents)
+			{
+				m_history[m_historyNext] = event;
+				m_historyNext = (m_historyNext + 1) % m_history.size();
+				m_historySize = std::min(m_historySize + 1, m_history.size());
+			}
+		}
+
+		std::ranges::sort(
+			m_lastFrameEvents,
+			[](const ProfileEvent& a, const ProfileEvent& b)
+			{
+				return std::tie(a.threadIndex, a.depth, a.start) < std::tie(b.threadIndex, b.depth, b.start);
+			});
+	}
+
+	void ProfileCapture::DrawFlameBars(nu::console::ConsoleRenderer& renderer, FrameArena& arena, uint16_t maxRows)
+	{
+		namespace vt = nu::console::vt;
+
+		const int64_t frameDuration = m_frameStart - m_lastFrameStart;
+		if (frameDuration <= 0 || m_lastFrameEvents.empty() || maxRows == 0)
+		{
+			return;
+		}
+
+		// Bars are colored by name, so a scope keeps its color from frame to frame
+		constexpr std::array colors = {
+			vt::color::BackgroundBrightBlue,
+			vt::color::BackgroundBrightGreen,
+			vt::color::BackgroundBrightYellow,
+			vt::color::BackgroundBrightMagenta,
+			vt::color::BackgroundBrightCyan,
+			vt::color::BackgroundBrightRed,
+		};
+
+		const int64_t width = renderer.GetWidth();
+		auto toColumn = [this, width, frameDuration](int64_t ticks)
+		{
+			return std::clamp<int64_t>((ticks - m_lastFrameStart) * width / frameDuration, 0, width);
+		};
+
+		// Rows fill the bottom of the renderer, above the row the commander uses
+		const int bottomRow = renderer.GetHeight() - 2;
+		const int topRow = std::max(0, bottomRow - maxRows + 1);
+		int y = topRow;
+
+		std::lock_guard lock(g_threadsMutex);
+
+		// Flag overflowing rings at the end of the first label row, as their scopes are missing from the bars
+		uint64_t droppedEvents = 0;
+		for (const auto& threadProfile : g_threads)
+		{
+			droppedEvents += threadProfile->droppedEvents.load(std::memory_order_relaxed);
+		}
+		if (droppedEvents > 0)
+		{
+			const auto droppedLabel = arena.Format("{} events dropped", droppedEvents);
+			renderer.DrawString(std::max<int64_t>(0, width - static_cast<int64_t>(droppedLabel.size())), topRow, droppedLabel, vt::color::ForegroundBrightYellow);
+		}
+
+		size_t i = 0;
+		while (i < m_lastFrameEvents.size() && y <= bottomRow)
+		{
+			// Each thread gets a label row, then one row per scope depth
+			const auto threadIndex = m_lastFrameEvents[i].threadIndex;
+			renderer.DrawString(0, y++, GetThreadName(*g_threads[threadIndex], arena), vt::color::ForegroundBrightWhite);
+
+			uint16_t maxDepth = 0;
+			for (; i < m_lastFrameEvents.size() && m_lastFrameEvents[i].threadIndex == threadIndex; ++i)
+			{
+				const auto& event = m_lastFrameEvents[i];
+				const int barY = y + event.depth;
+				const int64_t startX = toColumn(event.start);
+				const int64_t endX = std::min(std::max(toColumn(event.end), startX + 1), width);
+				if (barY > bottomRow || startX >= width)
+				{
+					continue;
+				}
+
+				maxDepth = std::max(maxDepth, event.depth);
+				const std::string_view name = event.name;
+				const auto color = colors[std::hash<std::string_view>{}(name) % colors.size()];
+				const auto label = name.substr(0, static_cast<size_t>(endX - startX));
+				renderer.DrawString(startX, barY, label, vt::color::ForegroundBlack, color);
+				for (int64_t x = startX + static_cast<int64_t>(label.size()); x < endX; ++x)
+				{
+					renderer.DrawChar(x, barY, ' ', vt::color::ForegroundBlack, color);
+				}
+			}
+
+			y += maxDepth + 1;
+		}
+	}
+
+	int64_t ProfileCapture::ExportChromeTrace(const std::filesystem::path& path) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			return -1;
+		}
+
+		// Timestamps are relative to the earliest event, in microseconds
+		const size_t firstEvent = (m_historyNext + m_history.size() - m_historySize) % std::max<size_t>(m_history.size(), 1);
+		auto getEvent = [this, firstEvent](size_t i) -> const ProfileEvent& { return m_history[(firstEvent + i) % m_history.size()]; };
+		int64_t origin = std::numeric_limits<int64_t>::max();
+		for (size_t i = 0; i < m_historySize; ++i)
+		{
+			origin = std::min(origin, getEvent(i).start);
+		}
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool isFirst = true;
+		{
+			std::lock_guard lock(g_threadsMutex);
+			for (const auto& threadProfile : g_threads)
+			{
+				file << (isFirst ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadProfile->index << ",\"args\":{\"name\":";
+				WriteJsonString(file, threadProfile->name.empty() ? std::format("Thread {}", threadProfile->index) : threadProfile->name);
+				file << "}}";
+				isFirst = false;
+			}
+		}
+
+		for (size_t i = 0; i < m_historySize; ++i)
+		{
+			const auto& event = getEvent(i);
+			file << (isFirst ? "" : ",\n") << "{\"name\":";
+			WriteJsonString(file, event.name);
+			file << std::format(
+				",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+				event.threadIndex,
+				TicksToMicroseconds(event.start - origin),
+				TicksToMicroseconds(event.end - event.start));
+			isFirst = false;
+		}
+		file << "\n]}\n";
+
+		return file ? static_cast<int64_t>(m_historySize) : -1;
+	}
+
+	uint64_t ProfileCapture::GetDroppedEventCount() const
+	{
+		std::lock_guard lock(g_threadsMutex);
+		uint64_t droppedEvents = 0;
+		for (const auto& threadProfile : g_threads)
+		{
+			droppedEvents += threadProfile->droppedEvents.load(std::memory_order_relaxed);
+		}
+		return droppedEvents;
+	}
+} // namespace engine
+} // namespace nu
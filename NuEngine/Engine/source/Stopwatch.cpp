@@ -5,7 +5,11 @@ namespace nu
 namespace engine
 {
 
-	Stopwatch::Stopwatch() : m_isRunning(false)
+	Stopwatch::Stopwatch() : m_clockSource(clock::GetDefaultSource())
+	{
+	}
+
+	Stopwatch::Stopwatch(ClockSource clockSource) : m_clockSource(clock::GetAvailableSource(clockSource))
 	{
 	}
 
@@ -17,9 +21,9 @@ namespace engine
 		}
 
 		// Only set start time on first start or after Reset is called
-		if (m_startTime == std::chrono::high_resolution_clock::time_point{})
+		if (m_startTime == 0)
 		{
-			m_startTime = std::chrono::high_resolution_clock::now();
+			m_startTime = clock::Now(m_clockSource);
 		}
 
 		m_isRunning = true;
@@ -32,31 +36,36 @@ namespace engine
 			return;
 		}
 
-		m_endTime = std::chrono::high_resolution_clock::now();
+		m_endTime = clock::Now(m_clockSource);
 		m_isRunning = false;
 	}
 
 	void Stopwatch::Reset()
 	{
 		m_isRunning = false;
-		m_startTime = std::chrono::high_resolution_clock::time_point{};
-		m_endTime = m_startTime;
+		m_startTime = 0;
+		m_endTime = 0;
 	}
 
 	void Stopwatch::Restart()
 	{
 		m_isRunning = true;
-		m_startTime = std::chrono::high_resolution_clock::now();
+		m_startTime = clock::Now(m_clockSource);
+	}
+
+	std::chrono::nanoseconds Stopwatch::ElapsedDuration() const
+	{
+		return std::chrono::round<std::chrono::nanoseconds>(ElapsedSeconds());
 	}
 
 	 std::chrono::duration<double, std::milli> Stopwatch::ElapsedMilliseconds() const
 	{
-		return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(ElapsedDuration());
+		return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(ElapsedSeconds());
 	 }
 
 	std::chrono::duration<double> Stopwatch::ElapsedSeconds() const
 	{
-		return std::chrono::duration_cast<std::chrono::duration<double>>(ElapsedDuration());
+		return clock::ToDuration(ElapsedTicks(), m_clockSource);
 	}
 
 	bool Stopwatch::IsRunning() const
@@ -0,0 +1,260 @@
+#include "NuEngine/TelemetryWriter.h"
+
+#include <condition_variable>
+#include <format>
+#include <iterator>
+#include <mutex>
+
+#include "NuEngine/Assertions.h"
+#include "NuEngine/Profiler.h"
+
+using namespace std::chrono_literals;
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		// How often the writer thread drains the queue
+		constexpr auto writeInterval = 100ms;
+
+		// Formatted rows are written in chunks of about this size
+		constexpr size_t writeChunkBytes = 64 * 1024;
+
+		double ToMs(std::chrono::duration<double> duration) noexcept
+		{
+			return duration.count() * 1000.0;
+		}
+	} // namespace
+
+	TelemetryWriter::~TelemetryWriter()
+	{
+		Stop();
+	}
+
+	size_t TelemetryWriter::AddCounter(std::string_view name)
+	{
+		VerifyElseCrash(!IsRunning());
+		VerifyElseCrash(m_counterNames.size() < maxCounters);
+		m_counterNames.emplace_back(name);
+		return m_counterNames.size() - 1;
+	}
+
+	bool TelemetryWriter::Start(const std::filesystem::path& directory)
+	{
+		if (IsRunning())
+		{
+			return true;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (!std::filesystem::is_directory(directory, error))
+		{
+			return false;
+		}
+
+		if (m_records == nullptr)
+		{
+			m_records = std::make_unique<RecordQueue>();
+		}
+
+		// Name files after the session's start time, so sessions don't overwrite each other
+		const auto sessionTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch());
+		m_sessionName = std::format("telemetry_{}", sessionTime.count());
+		m_directory = directory;
+		m_nextFileIndex = 0;
+		m_currentFileBytes = 0;
+		m_files.clear();
+
+		m_nextFrame = 0;
+		m_startTime = std::chrono::steady_clock::now();
+		m_droppedFrames.store(0, std::memory_order_relaxed);
+		m_writerThread = std::jthread([this](std::stop_token stopToken) { RunWriter(stopToken); });
+		return true;
+	}
+
+	void TelemetryWriter::Stop()
+	{
+		if (IsRunning())
+		{
+			m_writerThread.request_stop();
+			m_writerThread.join();
+		}
+	}
+
+	void TelemetryWriter::RecordFrame(const FrameTimings& frameTimings) noexcept
+	{
+		if (!IsRunning())
+		{
+			return;
+		}
+
+		Record record{ .frame = m_nextFrame++, .time = std::chrono::steady_clock::now(), .timings = frameTimings };
+		for (size_t i = 0; i < m_counterNames.size(); ++i)
+		{
+			record.counters[i] = m_counters[i].load(std::memory_order_relaxed);
+		}
+
+		if (!m_records->TryPush(record))
+		{
+			m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void TelemetryWriter::RunWriter(std::stop_token stopToken)
+	{
+		profiler::SetThreadName("Telemetry");
+
+		std::mutex mutex;
+		std::condition_variable_any wakeUp;
+		std::string output;
+		output.reserve(writeChunkBytes * 2);
+
+		Record record;
+		while (true)
+		{
+			// Check before draining, so everything recorded before Stop is written
+			const bool isStopping = stopToken.stop_requested();
+			while (m_records->TryPop(record))
+			{
+				AppendRow(record, output);
+				if (output.size() >= writeChunkBytes)
+				{
+					WriteOutput(output);
+				}
+			}
+			WriteOutput(output);
+
+			if (isStopping)
+			{
+				break;
+			}
+
+			std::unique_lock lock(mutex);
+			wakeUp.wait_for(lock, stopToken, writeInterval, []() { return false; });
+		}
+
+		m_file.close();
+	}
+
+	void TelemetryWriter::AppendRow(const Record& record, std::string& output) const
+	{
+		const auto& timings = record.timings;
+		AllocationCounts frameAllocations;
+		for (const auto& counts : timings.allocations)
+		{
+			frameAllocations.allocations += counts.allocations;
+			frameAllocations.bytes += counts.bytes;
+		}
+
+		HardwareCounts frameHardwareCounts;
+		for (const auto& counts : timings.hardwareCounts)
+		{
+			frameHardwareCounts += counts;
+		}
+		auto phaseCycles = [&timings](FramePhase phase) { return timings.hardwareCounts[static_cast<size_t>(phase)].cycles; };
+
+		std::format_to(
+			std::back_inserter(output),
+			"{},{:.6f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{},{},{:.4f},{:.4f},{:.4f},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{:.4f},{},{},{:.4f}",
+			record.frame,
+			std::chrono::duration<double>(record.time - m_startTime).count(),
+			ToMs(timings.totalFrameTime),
+			ToMs(timings.tickTime),
+			ToMs(timings.renderTime),
+			ToMs(timings.presentTime),
+			ToMs(timings.idleTime),
+			timings.ticks,
+			timings.inputEventsConsumed,
+			ToMs(timings.inputLatencyMax),
+			ToMs(timings.wakeError),
+			ToMs(timings.deadlineMiss),
+			timings.isRenderSkipped ? 1 : 0,
+			timings.isPresentSkipped ? 1 : 0,
+			timings.pacedFramesPerSecond,
+			frameAllocations.allocations,
+			frameAllocations.bytes,
+			timings.liveHeapBytes,
+			phaseCycles(FramePhase::Tick),
+			phaseCycles(FramePhase::Render),
+			phaseCycles(FramePhase::Present),
+			phaseCycles(FramePhase::Idle),
+			frameHardwareCounts.pageFaults,
+			timings.present.changedCells,
+			timings.present.runs,
+			timings.present.cursorBytes,
+			timings.present.colorBytes,
+			timings.present.textBytes,
+			ToMs(timings.present.writeTime),
+			timings.present.writes,
+			timings.present.isCoalesced ? 1 : 0,
+			ToMs(timings.terminalRoundTrip));
+		for (size_t i = 0; i < m_counterNames.size(); ++i)
+		{
+			std::format_to(std::back_inserter(output), ",{}", record.counters[i]);
+		}
+		output += '\n';
+	}
+
+	bool TelemetryWriter::WriteOutput(std::string& output)
+	{
+		if (output.empty())
+		{
+			return true;
+		}
+
+		if (!m_file.is_open() || (m_maxFileBytes > 0 && m_currentFileBytes >= m_maxFileBytes))
+		{
+			if (!OpenNextFile())
+			{
+				output.clear();
+				return false;
+			}
+		}
+
+		m_file.write(output.data(), static_cast<std::streamsize>(output.size()));
+		m_file.flush();
+		m_currentFileBytes += output.size();
+		output.clear();
+		return m_file.good();
+	}
+
+	bool TelemetryWriter::OpenNextFile()
+	{
+		m_file.close();
+
+		const auto path = m_directory / std::format("{}_{:04}.csv", m_sessionName, m_nextFileIndex++);
+		m_file.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_file.is_open())
+		{
+			return false;
+		}
+
+		m_files.push_back(path);
+		while (m_maxFiles > 0 && m_files.size() > m_maxFiles)
+		{
+			std::error_code error;
+			std::filesystem::remove(m_files.front(), error);
+			m_files.pop_front();
+		}
+
+		std::string header =
+			"frame,time_s,frame_ms,tick_ms,render_ms,present_ms,idle_ms,ticks,input_events,input_latency_max_ms,"
+			"wake_error_ms,deadline_miss_ms,render_skipped,present_skipped,paced_fps,allocations,allocated_bytes,live_heap_bytes,"
+			"tick_cycles,render_cycles,present_cycles,idle_cycles,page_faults,"
+			"changed_cells,runs,cursor_bytes,color_bytes,text_bytes,write_ms,writes,present_dropped,terminal_rtt_ms";
+		for (const auto& counterName : m_counterNames)
+		{
+			header += ',';
+			header += counterName;
+		}
+		header += '\n';
+
+		m_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+		m_currentFileBytes = header.size();
+		return m_file.good();
+	}
+} // namespace engine
+} // namespace nu
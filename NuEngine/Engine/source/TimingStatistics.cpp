@@ -0,0 +1,162 @@
+#include "NuEngine/TimingStatistics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "NuEngine/Assertions.h"
+
+namespace nu
+{
+namespace engine
+{
+	namespace
+	{
+		uint32_t ToMicroseconds(std::chrono::duration<double> duration) noexcept
+		{
+			const double microseconds = std::round(duration.count() * 1'000'000.0);
+			return static_cast<uint32_t>(std::clamp(microseconds, 0.0, static_cast<double>(std::numeric_limits<uint32_t>::max())));
+		}
+
+		std::chrono::duration<double> FromMicroseconds(double microseconds) noexcept
+		{
+			return std::chrono::duration<double>(microseconds / 1'000'000.0);
+		}
+
+		uint32_t AbsoluteDifference(uint32_t a, uint32_t b) noexcept
+		{
+			return a > b ? a - b : b - a;
+		}
+	} // namespace
+
+	TimingWindow::TimingWindow(size_t windowSize) : m_samples(windowSize)
+	{
+		VerifyElseCrash(windowSize > 0);
+	}
+
+	void TimingWindow::AddSample(std::chrono::duration<double> duration)
+	{
+		const uint32_t sample = ToMicroseconds(duration);
+
+		// Evict the oldest sample, along with its share of the jitter
+		if (m_sampleCount == m_samples.size())
+		{
+			const uint32_t oldestSample = GetSample(0);
+			--m_buckets[GetBucketIndex(oldestSample)];
+			m_budgetMisses -= IsOverBudget(oldestSample) ? 1 : 0;
+			if (m_sampleCount > 1)
+			{
+				m_totalJitter -= AbsoluteDifference(GetSample(1), oldestSample);
+			}
+			--m_sampleCount;
+		}
+
+		if (m_sampleCount > 0)
+		{
+			m_totalJitter += AbsoluteDifference(sample, GetSample(m_sampleCount - 1));
+		}
+
+		m_samples[m_nextSample] = sample;
+		m_nextSample = (m_nextSample + 1) % m_samples.size();
+		++m_sampleCount;
+		++m_buckets[GetBucketIndex(sample)];
+		m_budgetMisses += IsOverBudget(sample) ? 1 : 0;
+	}
+
+	void TimingWindow::SetBudget(std::chrono::duration<double> budget)
+	{
+		const uint32_t budgetMicroseconds = ToMicroseconds(budget);
+		if (budgetMicroseconds == m_budgetMicroseconds)
+		{
+			return;
+		}
+
+		m_budgetMicroseconds = budgetMicroseconds;
+		m_budgetMisses = 0;
+		for (size_t i = 0; i < m_sampleCount; ++i)
+		{
+			m_budgetMisses += IsOverBudget(GetSample(i)) ? 1 : 0;
+		}
+	}
+
+	void TimingWindow::Clear()
+	{
+		m_buckets.fill(0);
+		m_nextSample = 0;
+		m_sampleCount = 0;
+		m_totalJitter = 0;
+		m_budgetMisses = 0;
+	}
+
+	TimingStatistics TimingWindow::GetStatistics() const
+	{
+		TimingStatistics statistics;
+		statistics.samples = static_cast<uint32_t>(m_sampleCount);
+		statistics.budgetMisses = m_budgetMisses;
+		if (m_sampleCount == 0)
+		{
+			return statistics;
+		}
+
+		uint32_t maxSample = 0;
+		for (size_t i = 0; i < m_sampleCount; ++i)
+		{
+			maxSample = std::max(maxSample, GetSample(i));
+		}
+
+		// Percentiles report the top of their bucket, so they err on the slow side, but never beyond the maximum
+		auto getPercentile = [this, maxSample](double percentile)
+		{
+			const auto rank = static_cast<size_t>(std::ceil(percentile * m_sampleCount));
+			size_t count = 0;
+			for (size_t i = 0; i < m_buckets.size(); ++i)
+			{
+				count += m_buckets[i];
+				if (count >= rank)
+				{
+					return FromMicroseconds(std::min(GetBucketUpperBound(i), maxSample));
+				}
+			}
+			return FromMicroseconds(maxSample);
+		};
+
+		statistics.p50 = getPercentile(0.50);
+		statistics.p95 = getPercentile(0.95);
+		statistics.p99 = getPercentile(0.99);
+		statistics.max = FromMicroseconds(maxSample);
+		if (m_sampleCount > 1)
+		{
+			statistics.jitter = FromMicroseconds(static_cast<double>(m_totalJitter) / (m_sampleCount - 1));
+		}
+		return statistics;
+	}
+
+	/*static*/ size_t TimingWindow::GetBucketIndex(uint32_t microseconds) noexcept
+	{
+		if (microseconds < subBucketCount)
+		{
+			return microseconds;
+		}
+
+		// Split each power of two into subBucketCount buckets, using the bits just below the highest set bit
+		const uint32_t highestBit = static_cast<uint32_t>(std::bit_width(microseconds)) - 1;
+		const uint32_t shift = highestBit - subBucketBits;
+		const uint32_t subBucket = (microseconds >> shift) - subBucketCount;
+		return subBucketCount + shift * subBucketCount + subBucket;
+	}
+
+	/*static*/ uint32_t TimingWindow::GetBucketUpperBound(size_t bucketIndex) noexcept
+	{
+		if (bucketIndex < subBucketCount)
+		{
+			return static_cast<uint32_t>(bucketIndex);
+		}
+
+		const auto shift = static_cast<uint32_t>((bucketIndex - subBucketCount) / subBucketCount);
+		const auto subBucket = static_cast<uint32_t>((bucketIndex - subBucketCount) % subBucketCount);
+		const uint64_t lowerBound = static_cast<uint64_t>(subBucketCount + subBucket) << shift;
+		return static_cast<uint32_t>(std::min<uint64_t>(lowerBound + (uint64_t{ 1 } << shift) - 1, std::numeric_limits<uint32_t>::max()));
+	}
+} // namespace engine
+} // namespace nu
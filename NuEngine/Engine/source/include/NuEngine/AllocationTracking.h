@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Set to 1 in the Engine project's preprocessor definitions to replace the global operator new and delete with versions
+// that count heap allocations per frame phase. Off by default, as every allocation then updates shared counters.
+#ifndef NU_ENABLE_ALLOCATION_TRACKING
+#define NU_ENABLE_ALLOCATION_TRACKING 0
+#endif
+
+namespace nu
+{
+namespace engine
+{
+	// Part of the frame that heap allocations are attributed to
+	enum class FramePhase : uint8_t
+	{
+		// Outside the frame loop, such as during BeginPlay and EndPlay
+		Other,
+		Input,
+		Tick,
+		Render,
+		Present,
+		Idle,
+		Count
+	};
+
+	constexpr size_t framePhaseCount = static_cast<size_t>(FramePhase::Count);
+
+	// Number and total size of heap allocations
+	struct AllocationCounts
+	{
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+	};
+
+	// Heap allocations counted since the program started
+	struct AllocationSnapshot
+	{
+		std::array<AllocationCounts, framePhaseCount> phases;
+
+		// Bytes currently allocated, and the most that were ever allocated at once
+		uint64_t liveBytes = 0;
+		uint64_t peakLiveBytes = 0;
+	};
+
+	namespace allocations
+	{
+		// Whether the engine was built with allocation tracking; when not, snapshots are always zero
+		constexpr bool isTrackingEnabled = NU_ENABLE_ALLOCATION_TRACKING != 0;
+
+		// Sets the phase that allocations on all threads are attributed to, unless a thread set its own phase
+		void SetFramePhase(FramePhase phase) noexcept;
+
+		// Sets the phase that allocations on the calling thread are attributed to; FramePhase::Other follows SetFramePhase again
+		void SetThreadFramePhase(FramePhase phase) noexcept;
+
+		// Returns the allocations counted so far; subtract an earlier snapshot to get the allocations in between
+		AllocationSnapshot GetSnapshot() noexcept;
+	} // namespace allocations
+} // namespace engine
+} // namespace nu
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define NU_HAS_TSC 1
+#else
+#define NU_HAS_TSC 0
+#endif
+
+namespace nu
+{
+namespace engine
+{
+	// Clocks that timestamps can be read from
+	enum class ClockSource : uint8_t
+	{
+		// std::chrono::steady_clock, which is QueryPerformanceCounter on Windows
+		Steady,
+
+		// The CPU's time-stamp counter, read with a single instruction. Only used when it's invariant.
+		Tsc
+	};
+
+	// Timestamps are raw ticks of a clock source, so taking one costs as little as possible; ticks are only converted to
+	// durations when reporting. Only timestamps of the same source can be compared.
+	namespace clock
+	{
+		// Returns true if the CPU has an invariant TSC, which ticks at a constant rate on every core in every power state.
+		// The first call calibrates the TSC against the steady clock, which takes about 20ms.
+		bool IsTscAvailable();
+
+		// Returns the TSC if it's available, otherwise the steady clock
+		inline ClockSource GetDefaultSource()
+		{
+			return IsTscAvailable() ? ClockSource::Tsc : ClockSource::Steady;
+		}
+
+		// Returns the provided source if it's available, otherwise the steady clock
+		inline ClockSource GetAvailableSource(ClockSource source)
+		{
+			return source == ClockSource::Tsc && !IsTscAvailable() ? ClockSource::Steady : source;
+		}
+
+		// Returns the current time in ticks of the provided source, which must be available
+		inline int64_t Now(ClockSource source) noexcept
+		{
+#if NU_HAS_TSC
+			if (source == ClockSource::Tsc)
+			{
+				return static_cast<int64_t>(__rdtsc());
+			}
+#endif
+			return std::chrono::steady_clock::now().time_since_epoch().count();
+		}
+
+		// Returns the number of ticks per second of the provided source
+		double GetTicksPerSecond(ClockSource source);
+
+		// Converts a number of ticks of the provided source to a duration
+		inline std::chrono::duration<double> ToDuration(int64_t ticks, ClockSource source)
+		{
+			return std::chrono::duration<double>(static_cast<double>(ticks) / GetTicksPerSecond(source));
+		}
+	} // namespace clock
+} // namespace engine
+} // namespace nu
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <format>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace nu
+{
+namespace engine
+{
+	namespace details
+	{
+		// Converts a UTF-8 view to a char view for use with standard library parsing and formatting
+		inline std::string_view AsCharView(std::u8string_view text) noexcept
+		{
+			return std::string_view(reinterpret_cast<const char*>(text.data()), text.size());
+		}
+
+		// Converts a char view to a UTF-8 string
+		inline std::u8string ToU8String(std::string_view text)
+		{
+			return std::u8string(reinterpret_cast<const char8_t*>(text.data()), text.size());
+		}
+
+		// Parses a console variable value; returns false if the text isn't a valid value of type T
+		template<typename T>
+		bool ParseValue(std::u8string_view text, T& value)
+		{
+			const auto chars = AsCharView(text);
+			if constexpr (std::same_as<T, bool>)
+			{
+				if (chars == "1" || chars == "true" || chars == "on")
+				{
+					value = true;
+					return true;
+				}
+				if (chars == "0" || chars == "false" || chars == "off")
+				{
+					value = false;
+					return true;
+				}
+				return false;
+			}
+			else if constexpr (std::is_arithmetic_v<T>)
+			{
+				T parsed{};
+				auto [end, error] = std::from_chars(chars.data(), chars.data() + chars.size(), parsed);
+				if (error != std::errc{} || end != chars.data() + chars.size())
+				{
+					return false;
+				}
+				value = parsed;
+				return true;
+			}
+			else if constexpr (std::same_as<T, std::u8string>)
+			{
+				value.assign(text);
+				return true;
+			}
+			else
+			{
+				static_assert(std::same_as<T, std::string>, "Console variables must be bool, arithmetic, std::string or std::u8string");
+				value.assign(chars);
+				return true;
+			}
+		}
+
+		// Formats a console variable value for display
+		template<typename T>
+		std::u8string FormatValue(const T& value)
+		{
+			if constexpr (std::same_as<T, bool>)
+			{
+				return value ? u8"on" : u8"off";
+			}
+			else if constexpr (std::same_as<T, std::u8string>)
+			{
+				return value;
+			}
+			else if constexpr (std::is_arithmetic_v<T> && sizeof(T) == 1)
+			{
+				// Don't format 8-bit integers as characters
+				return ToU8String(std::format("{}", static_cast<int>(value)));
+			}
+			else
+			{
+				return ToU8String(std::format("{}", value));
+			}
+		}
+	} // namespace details
+
+	// Hashed registry of commander commands and typed console variables (cvars). The engine and games register
+	// into it so settings can be inspected, tuned and completed from the commander while the game is running.
+	//
+	// Commander syntax:
+	//   <command> [args...]   Runs a command
+	//   <variable>            Shows a variable's value
+	//   <variable> <value>    Sets a variable; bool variables also accept "toggle"
+	class CommandRegistry
+	{
+	public:
+		// Handler for a command; receives the words after the command name and returns a message to display
+		using CommandHandler = std::function<std::u8string(std::span<const std::u8string_view> args)>;
+
+		// Result of completing a partially typed line
+		struct Completion
+		{
+			// Line with the longest unambiguous completion applied
+			std::u8string line;
+
+			// Names matching the partial line; more than one if the completion is ambiguous
+			std::vector<std::u8string_view> candidates;
+		};
+
+		CommandRegistry() = default;
+
+		// Registers a command, replacing any command or variable with the same name
+		void RegisterCommand(std::u8string_view name, std::u8string_view description, CommandHandler handler);
+
+		// Registers a variable accessed through the provided functions, replacing any command or variable with the same name.
+		// The setter returns false to reject a value, which the commander reports as invalid.
+		template<typename T>
+		void RegisterVariable(std::u8string_view name, std::u8string_view description, std::function<T()> getValue, std::function<bool(const T&)> trySetValue)
+		{
+			Entry entry;
+			entry.description = description;
+			entry.getValue = [getValue]() { return details::FormatValue(getValue()); };
+			entry.setValue = [getValue, trySetValue](std::u8string_view text)
+			{
+				T value{};
+				if constexpr (std::same_as<T, bool>)
+				{
+					if (text == u8"toggle")
+					{
+						return trySetValue(!getValue());
+					}
+				}
+
+				if (!details::ParseValue(text, value))
+				{
+					return false;
+				}
+				return trySetValue(value);
+			};
+			AddEntry(name, std::move(entry));
+		}
+
+		// Registers a variable accessed through the provided functions, whose setter accepts any value of type T
+		template<typename T>
+		void RegisterVariable(std::u8string_view name, std::u8string_view description, std::function<T()> getValue, std::function<void(const T&)> setValue)
+		{
+			RegisterVariable<T>(
+				name,
+				description,
+				std::move(getValue),
+				std::function<bool(const T&)>(
+					[setValue = std::move(setValue)](const T& value)
+					{
+						setValue(value);
+						return true;
+					}));
+		}
+
+		// Registers a variable stored in the provided reference, which must outlive the registration.
+		// The optional callback runs after the value changes.
+		template<typename T>
+		void RegisterVariable(std::u8string_view name, std::u8string_view description, T& storage, std::function<void(const T&)> onChanged = {})
+		{
+			RegisterVariable<T>(
+				name,
+				description,
+				std::function<T()>([&storage]() { return storage; }),
+				std::function<void(const T&)>(
+					[&storage, onChanged](const T& value)
+					{
+						if (storage == value)
+						{
+							return;
+						}
+
+						storage = value;
+						if (onChanged)
+						{
+							onChanged(storage);
+						}
+					}));
+		}
+
+		// Removes a command or variable
+		void Unregister(std::u8string_view name);
+
+		// Parses a command argument the way bool variables are: 1, true or on, and 0, false or off. Returns false if the
+		// text is none of them.
+		static bool TryParseBool(std::u8string_view text, bool& value)
+		{
+			return details::ParseValue(text, value);
+		}
+
+		// Returns true if a command or variable with the name is registered
+		bool Contains(std::u8string_view name) const
+		{
+			return m_entries.contains(name);
+		}
+
+		// Runs a line of commander input; returns false if it doesn't name a registered command or variable.
+		// Any message for the user is written to output.
+		bool Execute(std::u8string_view line, std::u8string& output) const;
+
+		// Completes the name at the start of a partially typed line
+		Completion Complete(std::u8string_view line) const;
+
+		// Returns a listing of all commands and variables with their descriptions, one per line
+		std::u8string GetHelp() const;
+
+		// Delete copy/move construction and assignment
+	private:
+		CommandRegistry(CommandRegistry&) = delete;
+		CommandRegistry(CommandRegistry&&) = delete;
+		CommandRegistry& operator=(CommandRegistry&) = delete;
+		CommandRegistry& operator=(CommandRegistry&&) = delete;
+
+	private:
+		// A registered command or variable
+		struct Entry
+		{
+			std::u8string description;
+
+			// Set for commands
+			CommandHandler command;
+
+			// Set for variables
+			std::function<std::u8string()> getValue;
+			std::function<bool(std::u8string_view)> setValue;
+		};
+
+		// Heterogeneous hash so lookups by string view don't allocate
+		struct NameHash
+		{
+			using is_transparent = void;
+
+			size_t operator()(std::u8string_view name) const noexcept
+			{
+				return std::hash<std::u8string_view>{}(name);
+			}
+		};
+
+	private:
+		// Adds or replaces an entry
+		void AddEntry(std::u8string_view name, Entry&& entry);
+
+	private:
+		// Registered commands and variables by name
+		std::unordered_map<std::u8string, Entry, NameHash, std::equal_to<>> m_entries;
+	};
+} // namespace engine
+} // namespace nu
\ No newline at end of file
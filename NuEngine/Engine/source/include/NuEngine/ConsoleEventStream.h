@@ -1,9 +1,17 @@
 #pragma once
 
+#include <bitset>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "NuEngine/Console.h"
-#include <string>
+#include "NuEngine/LineEditor.h"
+#include "NuEngine/SpscQueue.h"
 
 namespace nu
 {
@@ -69,6 +77,128 @@ namespace console
 	};
 
 
+	// Polled keyboard state: keys currently held, plus keys pressed and released since the frame began
+	class KeyboardState
+	{
+	public:
+		// Returns true while the key is held down
+		bool IsKeyDown(Key key) const noexcept
+		{
+			return m_heldKeys.test(static_cast<size_t>(key));
+		}
+
+		// Returns true if the key went down this frame, even if it was released again before the frame ended
+		bool WasKeyPressed(Key key) const noexcept
+		{
+			return m_pressedKeys.test(static_cast<size_t>(key));
+		}
+
+		// Returns true if the key was released this frame
+		bool WasKeyReleased(Key key) const noexcept
+		{
+			return m_releasedKeys.test(static_cast<size_t>(key));
+		}
+
+		// Clears the pressed and released sets; held keys carry over
+		void BeginFrame() noexcept
+		{
+			m_pressedKeys.reset();
+			m_releasedKeys.reset();
+		}
+
+		// Records a key press; returns false for auto-repeat presses of a key that is already held
+		bool SetKeyDown(Key key) noexcept
+		{
+			const auto index = static_cast<size_t>(key);
+			if (m_heldKeys.test(index))
+			{
+				return false;
+			}
+
+			m_heldKeys.set(index);
+			m_pressedKeys.set(index);
+			return true;
+		}
+
+		// Records a key release; returns false if the key wasn't held
+		bool SetKeyUp(Key key) noexcept
+		{
+			const auto index = static_cast<size_t>(key);
+			if (!m_heldKeys.test(index))
+			{
+				return false;
+			}
+
+			m_heldKeys.reset(index);
+			m_releasedKeys.set(index);
+			return true;
+		}
+
+		// Releases all held keys, e.g. when key events stop being delivered
+		void ReleaseAll() noexcept
+		{
+			m_releasedKeys |= m_heldKeys;
+			m_heldKeys.reset();
+		}
+
+	private:
+		// One bit per Key value
+		static constexpr size_t KeyCount = 256;
+
+		std::bitset<KeyCount> m_heldKeys;
+		std::bitset<KeyCount> m_pressedKeys;
+		std::bitset<KeyCount> m_releasedKeys;
+	};
+
+	// Console input event decoded from the console input stream
+	struct InputEvent
+	{
+		enum class Type : uint8_t
+		{
+			Key,
+			Resize
+		};
+
+		Type type = Type::Key;
+
+		// Key events: whether the key was pressed or released
+		bool isKeyDown = false;
+
+		// Key events: platform virtual key code
+		uint16_t virtualKeyCode = 0;
+
+		// Key events: UTF-16 code unit produced by the key press, or zero
+		wchar_t character = 0;
+
+		// Resize events: new console size
+		uint16_t width = 0;
+		uint16_t height = 0;
+
+		// Time at which the event was read from the console
+		std::chrono::steady_clock::time_point timestamp;
+	};
+
+	// Summary of read timestamps for input events consumed since it was last taken
+	struct ConsumedInputSummary
+	{
+		// Number of consumed events
+		uint32_t count = 0;
+
+		// Earliest and latest read timestamps of consumed events
+		std::chrono::steady_clock::time_point oldest = std::chrono::steady_clock::time_point::max();
+		std::chrono::steady_clock::time_point newest = std::chrono::steady_clock::time_point::min();
+
+		// Sum of read timestamps relative to the oldest, for computing the average. Relative, so the sum stays small
+		// however long the clock has been running.
+		std::chrono::steady_clock::duration totalSinceOldest = std::chrono::steady_clock::duration::zero();
+
+		// Returns the average read timestamp of consumed events; only meaningful if count is non-zero
+		std::chrono::steady_clock::time_point GetAverageTimestamp() const noexcept
+		{
+			return oldest + totalSinceOldest / count;
+		}
+	};
+
 	// Interface for consumers of keyboard input
 	class IKeyboardInputConsumer
 	{
@@ -102,8 +232,28 @@ namespace console
 		~ConsoleEventStream();
 
 		// Processes all events in the input stream
+		// When the input thread is running, only drains events already decoded by it and makes no system calls.
 		void ProcessEvents();
 
+		// Blocks until input may be available, Wake is called or the timeout elapses; returns false on timeout.
+		// Input that doesn't produce events, such as focus changes, can also end the wait.
+		bool WaitForEvents(std::chrono::steady_clock::duration timeout);
+
+		// Ends the current or next WaitForEvents; can be called from any thread
+		void Wake();
+
+		// Starts a dedicated thread that blocks on the console input handle and queues decoded events for ProcessEvents
+		void StartInputThread();
+
+		// Stops the input thread, if running; events it already queued are still delivered by ProcessEvents
+		void StopInputThread();
+
+		// Returns true if the dedicated input thread is running
+		bool IsInputThreadRunning() const noexcept
+		{
+			return m_inputThread.joinable();
+		}
+
 		// Registers a consumer of keyboard input
 		// Consumers called in order of registration
 		void RegisterKeyboardInputConsumer(IKeyboardInputConsumer* consumer);
@@ -126,14 +276,85 @@ namespace console
 		// Sets the input mode for key events
 		void SetKeyInputMode(KeyInputMode mode);
 
-		// Returns the current line being built in Lines input mode, including control characters (ex. escape, backspace)
-		const std::wstring& GetCurrentLineRaw() const noexcept
+		// Returns the polled keyboard state, updated by ProcessEvents in Keys input mode
+		const KeyboardState& GetKeyboardState() const noexcept
+		{
+			return m_keyboardState;
+		}
+
+		// Starts a new frame of keyboard state; call once per frame before ProcessEvents
+		void BeginFrame() noexcept
+		{
+			m_keyboardState.BeginFrame();
+		}
+
+		// Whether key events are dispatched to keyboard consumers. Keyboard state is updated either way.
+		bool AreKeyCallbacksEnabled() const noexcept
+		{
+			return m_areKeyCallbacksEnabled;
+		}
+
+		// Enables or disables dispatching key events to keyboard consumers. Disable when all consumers poll
+		// GetKeyboardState to skip callback dispatch entirely. Line input is dispatched either way.
+		void SetKeyCallbacksEnabled(bool enableKeyCallbacks) noexcept
 		{
-			return m_currentLine;
+			m_areKeyCallbacksEnabled = enableKeyCallbacks;
+		}
+
+		// Returns the read timestamps of events consumed since the last call, and resets them.
+		// Key events count as consumed when a consumer handles them or they change the keyboard state; characters count when added to the current line.
+		ConsumedInputSummary TakeConsumedInputSummary() noexcept;
+
+		// Watches input for the reply to a cursor position request written at the provided time. Replies are matched to
+		// requests in the order they were written, and consumed instead of dispatched as key events or characters.
+		void ExpectStatusReport(std::chrono::steady_clock::time_point sendTime);
+
+		// Stops timing the cursor position requests written so far. Their replies are still consumed, as the console
+		// answers every request it supports; requests unanswered for several seconds are given up on.
+		void CancelStatusReports() noexcept;
+
+		// Returns the number of written cursor position requests whose replies haven't been read
+		size_t GetPendingStatusReportCount() const noexcept
+		{
+			return m_pendingStatusReports.size();
+		}
+
+		// Returns true while a reply to a cursor position request is expected
+		bool IsStatusReportPending() const noexcept
+		{
+			return !m_pendingStatusReports.empty();
+		}
+
+		// Returns the time from writing the last answered, timed cursor position request to reading its reply, and resets
+		// it; zero if no such reply was read since the last call
+		std::chrono::steady_clock::duration TakeStatusReportRoundTrip() noexcept
+		{
+			return std::exchange(m_statusReportRoundTrip, std::chrono::steady_clock::duration::zero());
+		}
+
+		// Returns the editor for the current line being built in Lines input mode
+		const LineEditor& GetLineEditor() const noexcept
+		{
+			return m_lineEditor;
 		}
 
 		// Returns the current line being built in Lines input mode
-		const std::u8string& GetCurrentLine();
+		const std::u8string& GetCurrentLine()
+		{
+			return m_lineEditor.GetText();
+		}
+
+		// Sets the handler called when tab is typed in Lines input mode; it returns the completed line
+		void SetLineCompletionHandler(std::function<std::u8string(std::u8string_view line)> handler)
+		{
+			m_lineCompletionHandler = std::move(handler);
+		}
+
+		// Returns true if escape or grave accent was typed in Lines input mode. Reset when the input mode changes.
+		bool IsLineInputCancelled() const noexcept
+		{
+			return m_isLineInputCancelled;
+		}
 
 		// Delete copy/move construction and assignment
 	private:
@@ -146,6 +367,34 @@ namespace console
 		// Helper to map a virtual key code to a Key enum
 		static std::pair<bool, Key> TryMapKey(uint16_t virtualKeyCode);
 
+		// Entry point for the dedicated input thread
+		void RunInputThread(std::stop_token stopToken);
+
+		// Reads and dispatches events directly from the console
+		void PollEvents();
+
+		// Dispatches a decoded event to consumers according to the current input mode
+		void DispatchEvent(const InputEvent& event);
+
+		// Dispatches a key press or release to keyboard consumers in Keys input mode
+		void DispatchKeyEvent(const InputEvent& event);
+
+		// Applies a character to the current line in Lines input mode, dispatching the line on enter
+		void HandleLineCharacter(wchar_t ch, std::chrono::steady_clock::time_point timestamp);
+
+		// Applies an extended key (arrows, home, end, delete) to the current line in Lines input mode
+		void HandleLineExtendedKey(wchar_t scanCode, std::chrono::steady_clock::time_point timestamp);
+
+		// Records the read timestamp of an event that was consumed
+		void RecordConsumedInput(std::chrono::steady_clock::time_point timestamp) noexcept;
+
+		// Holds back key events that may be part of the reply to a cursor position request; returns true if the event was
+		// held back or consumed. Held events that turn out not to be a reply are dispatched as usual.
+		bool TryConsumeStatusReport(const InputEvent& event);
+
+		// Dispatches the events held back as a possible status report reply
+		void DispatchHeldStatusReportEvents();
+
 	private:
 		// Console configuration at construction. Restored at destruction.
 		CachedConsoleState m_cachedConsoleState;
@@ -153,20 +402,72 @@ namespace console
 		// Current input mode for key events
 		KeyInputMode m_keyInputMode = KeyInputMode::Keys;
 
+		// Polled keyboard state, updated in Keys input mode
+		KeyboardState m_keyboardState;
+
+		// Whether key events are dispatched to keyboard consumers
+		bool m_areKeyCallbacksEnabled = true;
+
 		// Current line being built in Lines input mode
-		std::wstring m_currentLine;
+		LineEditor m_lineEditor;
+
+		// Completes the current line when tab is typed in Lines input mode
+		std::function<std::u8string(std::u8string_view line)> m_lineCompletionHandler;
 
-		// Current line being built in Lines input mode, converted to UTF-8
-		std::u8string m_currentLineUtf8;
+		// High surrogate waiting for the rest of its UTF-16 surrogate pair
+		wchar_t m_pendingHighSurrogate = 0;
 
-		// Whether m_currentLineUtf8 needs to be updated from m_currentLine
-		bool m_isCurrentLineUtf8Valid = false;
+		// Whether escape or grave accent was typed in Lines input mode
+		bool m_isLineInputCancelled = false;
 
 		// Registered consumers of keyboard input
 		std::vector<IKeyboardInputConsumer*> m_keyConsumers;
 
 		// Registered consumers of window resize events
 		std::vector<IWindowResizeConsumer*> m_resizeConsumers;
+
+		// Read timestamps of events consumed since TakeConsumedInputSummary was last called
+		ConsumedInputSummary m_consumedInputSummary;
+
+		// A written cursor position request awaiting its reply
+		struct PendingStatusReport
+		{
+			std::chrono::steady_clock::time_point sendTime;
+
+			// Whether the reply's round trip is reported; false once cancelled
+			bool isTimed = true;
+		};
+
+		// Written cursor position requests awaiting replies, oldest first
+		std::deque<PendingStatusReport> m_pendingStatusReports;
+
+		// Events of a possible status report reply read so far, and how many of them were characters
+		std::vector<InputEvent> m_statusReportEvents;
+		size_t m_statusReportLength = 0;
+
+		// Round trip of the last answered cursor position request, until taken
+		std::chrono::steady_clock::duration m_statusReportRoundTrip = std::chrono::steady_clock::duration::zero();
+
+		// Whether held events are being dispatched, which must not be held back again
+		bool m_isDispatchingHeldStatusReportEvents = false;
+
+		// Whether releases of the last reply's keys may still follow, until the next key press
+		bool m_isReleasingStatusReport = false;
+
+		// Events decoded by the input thread, waiting to be dispatched by ProcessEvents
+		nu::engine::SpscQueue<InputEvent, 1024> m_inputQueue;
+
+		// Signaled to wake the input thread when it should exit. Windows HANDLE.
+		void* m_hStopInputThreadEvent = nullptr;
+
+		// Signaled by the input thread after queuing events. Windows HANDLE.
+		void* m_hInputQueuedEvent = nullptr;
+
+		// Signaled by Wake. Windows HANDLE.
+		void* m_hWakeEvent = nullptr;
+
+		// Dedicated thread reading console input, if started
+		std::jthread m_inputThread;
 	};
 } // namespace console
 } // namespace nu
\ No newline at end of file
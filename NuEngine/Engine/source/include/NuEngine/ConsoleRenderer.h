@@ -1,17 +1,33 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <semaphore>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "NuEngine/Assertions.h"
 #include "NuEngine/Console.h"
+#include "NuEngine/RenderStatistics.h"
 #include "NuEngine/VirtualTerminalSequences.h"
 
 namespace nu
 {
 namespace console
 {
+	// What the renderer's debug heatmap shows by tinting the background of every cell
+	enum class HeatmapMode : uint8_t
+	{
+		None,
+
+		// Draws per cell this frame: green for one, yellow for two, red for three or more; untinted cells weren't drawn
+		Overdraw,
+
+		// Cells Present wrote to the console: red this frame, fading through yellow and green over the next few frames
+		Changes
+	};
+
 	// Rendering interface for drawing to the console
 	class ConsoleRenderer
 	{
@@ -236,6 +252,17 @@ namespace console
 		// Renders the current buffer to the console
 		void Present();
 
+		// Ends the current frame without rendering it, keeping the console showing the last presented frame.
+		// Draws made this frame count as stale on the next Present, as if Present had been called.
+		void DiscardFrame() noexcept
+		{
+			++m_currentPresentId;
+			if (IsCountingCells())
+			{
+				m_cellWrites.assign(m_cellWrites.size(), 0);
+			}
+		}
+
 		// Resizes the renderer to the desired width and height and optionally attempts to resize window
 		void Resize(uint16_t sizeX, uint16_t sizeY, bool shouldResizeWindow = false);
 
@@ -265,6 +292,70 @@ namespace console
 			m_enableIncrementalDrawing = enableIncrementalDrawing;
 		}
 
+		// Enables or disables async present. When enabled, Present hands its output to an output thread instead of
+		// writing it, so a terminal that can't keep up doesn't block the caller. While the output thread is still writing,
+		// Present drops the frame, and the console catches up with the latest frame once the output thread is free.
+		void SetAsyncPresentEnabled(bool enableAsyncPresent);
+
+		// Whether Present writes on an output thread
+		bool IsAsyncPresentEnabled() const noexcept
+		{
+			return m_outputThread.joinable();
+		}
+
+		// Appends a cursor position request (Device Status Report) to the output of the next frame that's written. The
+		// console replies with input once it has processed everything before it, which ConsoleEventStream can time.
+		void RequestStatusReport() noexcept
+		{
+			m_isStatusReportRequested = true;
+		}
+
+		// Withdraws a cursor position request that hasn't been written yet
+		void CancelStatusReport() noexcept
+		{
+			m_isStatusReportRequested = false;
+		}
+
+		// Returns what the last Present scanned, wrote and how long writing took
+		const PresentStatistics& GetLastPresentStatistics() const noexcept
+		{
+			return m_lastPresentStatistics;
+		}
+
+		// Enables or disables counting draws per cell. Costs a counter update per draw while enabled.
+		void SetCellStatisticsEnabled(bool enableCellStatistics) noexcept
+		{
+			m_areCellStatisticsEnabled = enableCellStatistics;
+		}
+
+		// Whether draws are counted per cell
+		bool AreCellStatisticsEnabled() const noexcept
+		{
+			return m_areCellStatisticsEnabled;
+		}
+
+		// Returns the cell statistics of the last Present; zero unless cell statistics or the heatmap were enabled
+		const CellStatistics& GetLastCellStatistics() const noexcept
+		{
+			return m_lastCellStatistics;
+		}
+
+		// Sets what the debug heatmap shows. The heatmap only tints what Present writes to the console, so it doesn't
+		// change the buffers or count as a change itself. Cells are counted while it's shown, even with statistics disabled.
+		void SetHeatmapMode(HeatmapMode heatmapMode) noexcept
+		{
+			m_heatmapMode = heatmapMode;
+		}
+
+		// Returns what the debug heatmap shows
+		HeatmapMode GetHeatmapMode() const noexcept
+		{
+			return m_heatmapMode;
+		}
+
+		// Splits the first UTF-8 code point off the provided text; returns an empty code point if the text is empty or the sequence is invalid
+		static std::pair<std::u8string, std::u8string_view> ReadNextU8Char(std::u8string_view data);
+
 		// Delete copy/move construction and assignment
 	private:
 		ConsoleRenderer(ConsoleRenderer&) = delete;
@@ -294,8 +385,26 @@ namespace console
 		// Retrieves the front buffer that was last presented
 		std::vector<Glyph>& GetFrontBuffer();
 
-		// Helper function to decode a single UTF-8 code point
-		std::pair<std::u8string, std::u8string_view> ReadNextU8Char(std::u8string_view data);
+		// Writes output handed over by Present until stopped
+		void RunOutputThread(std::stop_token stopToken);
+
+		// Stops the output thread after it finishes its current write
+		void StopOutputThread();
+
+		// Whether draws are counted per cell this frame
+		bool IsCountingCells() const noexcept
+		{
+			return m_areCellStatisticsEnabled || m_heatmapMode != HeatmapMode::None;
+		}
+
+		// Counts a draw to the cell at the provided index, if cells are being counted
+		void CountCellWrite(size_t index) noexcept
+		{
+			if (IsCountingCells())
+			{
+				++m_cellWrites[index];
+			}
+		}
 
 	private:
 		// True if the buffers were resized since last Present
@@ -319,9 +428,34 @@ namespace console
 		// Builder used when presenting; reused to avoid allocations on each Present call
 		std::string m_builder;
 
+		// Output thread for async present, signalled with output to write. While it's writing, the output belongs to it;
+		// Present swaps its builder with the output once the thread is done, so neither buffer is reallocated.
+		std::jthread m_outputThread;
+		std::binary_semaphore m_outputRequested{ 0 };
+		std::atomic<bool> m_isOutputThreadWriting = false;
+		std::atomic<double> m_lastOutputWriteSeconds = 0.0;
+		std::string m_output;
+
 		// Counter to track how long ago a glyph was drawn
 		uint64_t m_currentPresentId = 0;
 
+		// Draws to each cell this frame, counted while cell statistics or the heatmap are enabled
+		std::vector<uint32_t> m_cellWrites;
+
+		// Per cell, 255 when it last changed, halving every Present since; fades the heatmap of changes
+		std::vector<uint8_t> m_cellChangeHeat;
+
+		// Heatmap tint each cell was last written to the console with, as an index into the heatmap colors; 0 is untinted
+		std::vector<uint8_t> m_cellHeatLevels;
+
+		CellStatistics m_lastCellStatistics;
+		PresentStatistics m_lastPresentStatistics;
+		HeatmapMode m_heatmapMode = HeatmapMode::None;
+		bool m_areCellStatisticsEnabled = false;
+
+		// Whether the next written frame ends with a cursor position request
+		bool m_isStatusReportRequested = false;
+
 		// Console configuration at construction. Restored at destruction.
 		CachedConsoleState m_cachedConsoleState;
 	};
@@ -1,19 +1,63 @@
 #pragma once
 
-#include "NuEngine/Game.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <semaphore>
+#include <thread>
+
+#include "NuEngine/AllocationTracking.h"
+#include "NuEngine/CommandRegistry.h"
 #include "NuEngine/ConsoleEventStream.h"
+#include "NuEngine/FrameArena.h"
+#include "NuEngine/FrameTimings.h"
+#include "NuEngine/FramePacer.h"
+#include "NuEngine/Game.h"
+#include "NuEngine/JobSystem.h"
+#include "NuEngine/Profiler.h"
+#include "NuEngine/TelemetryWriter.h"
+#include "NuEngine/TimingStatistics.h"
 
 namespace nu
 {
 namespace engine
 {
-	struct FrameTimings
+	// Timings tracked over a rolling window of recent frames
+	enum class TimingBucket : uint8_t
+	{
+		Frame,
+		Tick,
+		Render,
+		Present,
+		Idle,
+		Count
+	};
+
+	// When the engine runs frames
+	enum class RenderMode : uint8_t
+	{
+		// Runs frames continuously at the target frame rate
+		Continuous,
+
+		// Runs a frame only after input, a window resize, a redraw request or a timed redraw, and otherwise sleeps.
+		// Frames are still limited to the target frame rate.
+		OnDemand
+	};
+
+	// What the engine does when frames take longer than the target frame time
+	enum class OverloadPolicy : uint8_t
 	{
-		std::chrono::duration<double> totalFrameTime = std::chrono::duration<double>::zero();
-		std::chrono::duration<double> tickTime = std::chrono::duration<double>::zero();
-		std::chrono::duration<double> renderTime = std::chrono::duration<double>::zero();
-		std::chrono::duration<double> presentTime = std::chrono::duration<double>::zero();
-		std::chrono::duration<double> idleTime = std::chrono::duration<double>::zero();
+		// Keep running every phase of every frame, late
+		None,
+
+		// Keep ticking and rendering, but skip presenting for up to the maximum number of skipped frames in a row
+		SkipPresent,
+
+		// Keep ticking, but skip rendering and presenting for up to the maximum number of skipped frames in a row
+		SkipRenderAndPresent,
+
+		// Lower the paced frame rate while frames run over, and raise it back towards the target once they fit comfortably
+		ReduceFrameRate
 	};
 
 	class Engine : private nu::console::IKeyboardInputConsumer, private nu::console::IWindowResizeConsumer
@@ -72,6 +116,214 @@ namespace engine
 			return m_targetFramesPerSecond;
 		}
 
+		// Sets a fixed simulation rate. Game::Tick then runs with a constant delta time as many times as needed to
+		// catch up with real time, and Render receives an interpolation alpha. Zero ticks once per frame with a variable delta time.
+		void SetFixedTicksPerSecond(uint16_t fixedTicksPerSecond) noexcept
+		{
+			m_fixedTicksPerSecond = fixedTicksPerSecond;
+			m_tickAccumulator = std::chrono::duration<double>::zero();
+		}
+
+		// Returns the fixed simulation rate; zero when ticking once per frame
+		uint16_t GetFixedTicksPerSecond() const noexcept
+		{
+			return m_fixedTicksPerSecond;
+		}
+
+		// Sets the maximum number of fixed ticks run in one frame. Time beyond that is dropped, so frames that
+		// run long slow the simulation down instead of causing ever longer catch-up frames.
+		void SetMaxTicksPerFrame(uint16_t maxTicksPerFrame) noexcept
+		{
+			m_maxTicksPerFrame = std::max<uint16_t>(maxTicksPerFrame, 1);
+		}
+
+		// Returns the maximum number of fixed ticks run in one frame
+		uint16_t GetMaxTicksPerFrame() const noexcept
+		{
+			return m_maxTicksPerFrame;
+		}
+
+		// Returns how far the current frame is between the last fixed tick and the next one, in [0, 1); 1 without a fixed tick rate
+		double GetInterpolationAlpha() const noexcept
+		{
+			return m_interpolationAlpha;
+		}
+
+		// Enables or disables pipelined ticking. When enabled, Game::Tick for the next frame runs on a simulation thread
+		// while Render and Present run for the current frame, so frame time approaches max(tick, render) instead of their sum.
+		// Render must then only read state that Tick publishes through a TripleBuffer. Input callbacks, window resizes and
+		// commander commands still run on the main thread while no tick is running; late-latched input is skipped.
+		void SetPipelinedTickEnabled(bool enablePipelinedTick) noexcept
+		{
+			m_isPipelinedTickEnabled = enablePipelinedTick;
+		}
+
+		// Whether Game::Tick runs on a simulation thread concurrently with Render
+		bool IsPipelinedTickEnabled() const noexcept
+		{
+			return m_isPipelinedTickEnabled;
+		}
+
+		// Sets what the engine does when frames take longer than the target frame time. Input is processed and the game
+		// ticked every frame under any policy, so input isn't stalled by slow rendering or presenting.
+		void SetOverloadPolicy(OverloadPolicy overloadPolicy) noexcept
+		{
+			m_overloadPolicy = overloadPolicy;
+		}
+
+		// Returns what the engine does when frames take longer than the target frame time
+		OverloadPolicy GetOverloadPolicy() const noexcept
+		{
+			return m_overloadPolicy;
+		}
+
+		// Sets how many frames in a row the skip overload policies may skip before a frame is presented regardless
+		void SetMaxSkippedFrames(uint16_t maxSkippedFrames) noexcept
+		{
+			m_maxSkippedFrames = maxSkippedFrames;
+		}
+
+		// Returns how many frames in a row the skip overload policies may skip
+		uint16_t GetMaxSkippedFrames() const noexcept
+		{
+			return m_maxSkippedFrames;
+		}
+
+		// Returns the frame rate currently paced to; below the target while OverloadPolicy::ReduceFrameRate has reduced it
+		uint16_t GetPacedFramesPerSecond() const noexcept
+		{
+			return m_pacedFramesPerSecond;
+		}
+
+		// Sets when frames run. Static screens such as menus, results and turn-based games can use RenderMode::OnDemand
+		// to use almost no CPU while nothing changes; delta time then spans the whole time the engine slept.
+		void SetRenderMode(RenderMode renderMode) noexcept
+		{
+			m_renderMode = renderMode;
+		}
+
+		// Returns when frames run
+		RenderMode GetRenderMode() const noexcept
+		{
+			return m_renderMode;
+		}
+
+		// Requests another frame in RenderMode::OnDemand; can be called from any thread while a game is playing
+		void RequestRedraw();
+
+		// Requests a frame after the provided delay in RenderMode::OnDemand, e.g. for a countdown or blinking cursor.
+		// Only the earliest pending timed redraw is kept. Call from Tick, Render or input callbacks.
+		void RequestRedrawAfter(std::chrono::duration<double> delay);
+
+		// Enables or disables reading console input on a dedicated thread. When enabled, input arriving during
+		// Tick or Present is queued immediately and the frame drains it without any console system calls.
+		void SetInputThreadEnabled(bool enableInputThread);
+
+		// Whether console input is read on a dedicated thread
+		bool IsInputThreadEnabled() const noexcept
+		{
+			return m_isInputThreadEnabled;
+		}
+
+		// Enables or disables late-latched input. When enabled, input is processed again after Tick, right before
+		// Render, so input callbacks can apply the freshest input to presentation state such as cursors or cameras.
+		void SetLateLatchInputEnabled(bool enableLateLatchInput) noexcept
+		{
+			m_isLateLatchInputEnabled = enableLateLatchInput;
+		}
+
+		// Whether input is processed again right before Render
+		bool IsLateLatchInputEnabled() const noexcept
+		{
+			return m_isLateLatchInputEnabled;
+		}
+
+		// Enables or disables counting CPU cycles and page faults per frame phase into FrameTimings::hardwareCounts, and
+		// showing them in the frame timings overlay. Stays disabled if the counters can't be read. Call from the main thread.
+		void SetHardwareCountersEnabled(bool enableHardwareCounters);
+
+		// Whether hardware counts are recorded per frame phase
+		bool AreHardwareCountersEnabled() const noexcept
+		{
+			return m_areHardwareCountersEnabled;
+		}
+
+		// Enables or disables pacing presents to the terminal. When enabled, a cursor position request is written after a
+		// presented frame every so often, and presents are skipped until the terminal's smoothed round trip to answer one
+		// has passed since the last present, so slow terminals don't build up a backlog of frames. Disabling withdraws any
+		// request still out at the start of the next frame. Pacing stops if the terminal doesn't answer the requests, until
+		// it's enabled again.
+		void SetTerminalPacingEnabled(bool enableTerminalPacing) noexcept
+		{
+			m_isTerminalPacingEnabled = enableTerminalPacing;
+			m_isTerminalUnanswering = false;
+		}
+
+		// Whether presents are paced to the terminal's measured round trip
+		bool IsTerminalPacingEnabled() const noexcept
+		{
+			return m_isTerminalPacingEnabled;
+		}
+
+		// Returns the smoothed time from presenting a frame to reading the terminal's answer to a cursor position request
+		// written after it; zero until terminal pacing has measured it
+		std::chrono::duration<double> GetTerminalRoundTrip() const noexcept
+		{
+			return m_terminalRoundTrip;
+		}
+
+		// Returns the registry of commander commands and console variables. Games may register their own; they should
+		// unregister them in EndPlay.
+		CommandRegistry& GetCommands() noexcept
+		{
+			return m_commands;
+		}
+
+		// Returns the job system for spreading game work across cores. Its workers run for the engine's lifetime.
+		JobSystem& GetJobSystem() noexcept
+		{
+			return m_jobSystem;
+		}
+
+		// Returns the arena for allocations that only last the current frame, for use in Tick, Render and input callbacks.
+		// It is reset at the end of each frame. With pipelined ticking, Tick runs on another thread and gets its own
+		// arena, reset before each tick.
+		FrameArena& GetFrameArena() noexcept
+		{
+			return m_tickThread.joinable() && m_tickThread.get_id() == std::this_thread::get_id() ? m_tickArena : m_frameArena;
+		}
+
+		// Returns true while the key is held down
+		bool IsKeyDown(nu::console::Key key) const noexcept
+		{
+			return m_eventStream != nullptr && m_eventStream->GetKeyboardState().IsKeyDown(key);
+		}
+
+		// Returns true if the key went down this frame
+		bool WasKeyPressed(nu::console::Key key) const noexcept
+		{
+			return m_eventStream != nullptr && m_eventStream->GetKeyboardState().WasKeyPressed(key);
+		}
+
+		// Returns true if the key was released this frame
+		bool WasKeyReleased(nu::console::Key key) const noexcept
+		{
+			return m_eventStream != nullptr && m_eventStream->GetKeyboardState().WasKeyReleased(key);
+		}
+
+		// Enables or disables OnKeyDown/OnKeyUp callbacks. Games that only poll keyboard state can disable them to
+		// skip callback dispatch entirely; the engine's own keys (escape, commander) keep working.
+		void SetKeyCallbacksEnabled(bool enableKeyCallbacks) noexcept
+		{
+			m_areKeyCallbacksEnabled = enableKeyCallbacks;
+		}
+
+		// Whether OnKeyDown/OnKeyUp callbacks are dispatched
+		bool AreKeyCallbacksEnabled() const noexcept
+		{
+			return m_areKeyCallbacksEnabled;
+		}
+
 		// Returns the frame timings of the last frame
 		const FrameTimings& GetLastFrameTimings() const noexcept
 		{
@@ -138,6 +390,35 @@ namespace engine
 			return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(m_lastFrameTimings.idleTime);
 		}
 
+		// Returns the frame timings of the most recent frame that consumed input
+		const FrameTimings& GetLastInputFrameTimings() const noexcept
+		{
+			return m_lastInputFrameTimings;
+		}
+
+		// Returns the telemetry writer, to add counters or start recording every frame's timings to files
+		TelemetryWriter& GetTelemetry() noexcept
+		{
+			return m_telemetry;
+		}
+
+		// Returns percentiles, jitter and budget misses of a timing over recent frames. Frames miss the budget when they
+		// take over 10% longer than the target frame time; phases miss it when they alone take longer than the target
+		// frame time. Skipped renders and presents aren't counted.
+		TimingStatistics GetTimingStatistics(TimingBucket bucket) const
+		{
+			return m_timingWindows[static_cast<size_t>(bucket)].GetStatistics();
+		}
+
+		// Clears the timing statistics, such as after a change that invalidates earlier frames
+		void ResetTimingStatistics()
+		{
+			for (auto& timingWindow : m_timingWindows)
+			{
+				timingWindow.Clear();
+			}
+		}
+
 	private:
 		// Delete copy/move construction and assignment
 		Engine(Engine&) = delete;
@@ -145,16 +426,139 @@ namespace engine
 		Engine& operator=(Engine&) = delete;
 		Engine& operator=(Engine&&) = delete;
 
+		// Advances the simulation for a frame, either once or in fixed steps; returns the number of ticks run
+		uint16_t TickGame(std::chrono::duration<double> deltaTime);
+
+		// Phases of a frame skipped by the overload policy
+		enum class FrameSkip : uint8_t
+		{
+			None,
+			Present,
+			RenderAndPresent
+		};
+
+		// Applies the overload policy based on the last frame's timings; returns what to skip this frame
+		FrameSkip ApplyOverloadPolicy();
+
+		// Takes the terminal's answers to cursor position requests into the smoothed round trip, and requests another
+		// with the next present when due
+		void UpdateTerminalPacing(nu::console::ConsoleEventStream& eventStream, nu::console::ConsoleRenderer& renderer);
+
+		// Returns true if presenting now would outpace the terminal, requesting a redraw for when it won't in RenderMode::OnDemand
+		bool IsPresentAheadOfTerminal();
+
+		// Starts the simulation thread used for pipelined ticking, if not running
+		void StartTickThread();
+
+		// Stops the simulation thread used for pipelined ticking, if running; must not be called while a tick is in flight
+		void StopTickThread();
+
+		// Runs ticks requested by the main thread until stopped
+		void RunTickThread(std::stop_token stopToken);
+
+		// Registers the engine's built-in commands and console variables
+		void RegisterCommands();
+
+		// In RenderMode::OnDemand, sleeps until a frame is needed
+		void WaitForRedraw(nu::console::ConsoleEventStream& eventStream);
+
+		// Adds the last frame's timings to the rolling timing statistics
+		void RecordTimingStatistics();
+
+		// Draws the FPS counter and frame timings overlays, if enabled
+		void DrawOverlays(nu::console::ConsoleRenderer& renderer);
+
+		// Draws the last frame's heap allocations beside the frame timings overlay, whose first and last rows are at the
+		// provided positions, and the heap totals under its last row; returns the row of the heap totals
+		int DrawAllocationStats(nu::console::ConsoleRenderer& renderer, int timingsX, int timingsY, int lastRowY);
+
+		// Draws the last frame's hardware counts of each timed phase, starting at the provided position
+		void DrawHardwareCounterStats(nu::console::ConsoleRenderer& renderer, int x, int y);
+
+		// Adds the hardware counts since the last phase ended to the provided phase, which is ending
+		void RecordHardwareCounts(FramePhase endingPhase);
+
+		// Draws the commander and any output from the last command
+		void DrawCommander(nu::console::ConsoleRenderer& renderer, const nu::console::ConsoleEventStream& eventStream);
+
 	private:
 		Game* m_game = nullptr;
+		nu::console::ConsoleEventStream* m_eventStream = nullptr;
+		nu::console::ConsoleRenderer* m_renderer = nullptr;
+		CommandRegistry m_commands;
+		JobSystem m_jobSystem;
+		FramePacer m_framePacer;
+
+		// Per-frame arenas for the main thread, and for the simulation thread when ticking is pipelined
+		FrameArena m_frameArena;
+		FrameArena m_tickArena;
+
+		// Rolling windows of recent frames' timings, indexed by TimingBucket
+		std::array<TimingWindow, static_cast<size_t>(TimingBucket::Count)> m_timingWindows;
+
+		// Records frame timings to files in the background while running
+		TelemetryWriter m_telemetry;
+		std::string m_telemetryDirectory = "telemetry";
+
+		// Profile events of recent frames, for the flame bars and trace export
+		ProfileCapture m_profileCapture;
+		bool m_showProfiler = false;
+
+		// Allocation counts at the end of the last frame, to compute the next frame's allocations from
+		AllocationSnapshot m_lastAllocationSnapshot;
+
+		// Hardware counts of the current frame's phases so far, and the read the current phase started at
+		std::array<HardwareCounts, framePhaseCount> m_frameHardwareCounts;
+		HardwareCounts m_lastHardwareCounts;
+		bool m_areHardwareCountersEnabled = false;
+
+		// Smoothed terminal round trip, and when the last cursor position request and present were written
+		std::chrono::duration<double> m_terminalRoundTrip = std::chrono::duration<double>::zero();
+		std::chrono::steady_clock::time_point m_lastTerminalProbeTime;
+		std::chrono::steady_clock::time_point m_lastPresentTime;
+		bool m_isTerminalPacingEnabled = false;
+
+		// Whether the terminal left several cursor position requests unanswered, so no more are sent
+		bool m_isTerminalUnanswering = false;
+
+		std::u8string m_commanderOutput;
 		bool m_shouldStopGame = false;
+		bool m_isInputThreadEnabled = false;
+		bool m_isLateLatchInputEnabled = false;
+		bool m_isPipelinedTickEnabled = false;
+		bool m_areKeyCallbacksEnabled = true;
 		bool m_isCommanderEnabled = false;
 		bool m_showFps = false;
 		bool m_showFrameTimings = false;
+		RenderMode m_renderMode = RenderMode::Continuous;
+		std::atomic<bool> m_isRedrawRequested = false;
+		std::chrono::steady_clock::time_point m_nextTimedRedraw = std::chrono::steady_clock::time_point::max();
 		uint16_t m_renderSizeX = 0;
 		uint16_t m_renderSizeY = 0;
 		uint16_t m_targetFramesPerSecond = 60;
+		uint16_t m_fixedTicksPerSecond = 0;
+		uint16_t m_maxTicksPerFrame = 5;
+		OverloadPolicy m_overloadPolicy = OverloadPolicy::None;
+		uint16_t m_maxSkippedFrames = 2;
+		uint16_t m_consecutiveSkippedFrames = 0;
+		uint16_t m_pacedFramesPerSecond = 60;
+		uint16_t m_overloadedFrames = 0;
+		uint16_t m_underloadedFrames = 0;
+		std::chrono::duration<double> m_tickAccumulator = std::chrono::duration<double>::zero();
+		double m_interpolationAlpha = 1.0;
 		FrameTimings m_lastFrameTimings;
+		FrameTimings m_lastInputFrameTimings;
+
+		// Simulation thread for pipelined ticking, signalled once per frame to run a tick and signalling back when done
+		std::jthread m_tickThread;
+		std::binary_semaphore m_tickRequested{ 0 };
+		std::binary_semaphore m_tickCompleted{ 0 };
+
+		// Passed to and returned from the simulation thread; only accessed by the side that currently owns the tick
+		std::chrono::duration<double> m_pipelinedDeltaTime = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> m_pipelinedTickTime = std::chrono::duration<double>::zero();
+		uint16_t m_pipelinedTicks = 0;
+		HardwareCounts m_pipelinedTickHardwareCounts;
 	};
 } // namespace engine
 } // namespace nu
\ No newline at end of file
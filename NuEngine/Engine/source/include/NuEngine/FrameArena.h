@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace nu
+{
+namespace engine
+{
+	// Monotonic arena for short-lived allocations, released all at once by Reset. Allocation is a pointer bump and
+	// deallocation does nothing. When a frame needs more than the arena's buffer, the overflow comes from the heap and
+	// the buffer grows to fit at the next Reset, so steady-state frames make no heap allocations.
+	//
+	// Use through GetResource with std::pmr containers, or format text directly into the arena:
+	//
+	//   std::pmr::vector<int> visible(arena.GetResource());
+	//   renderer.DrawString(0, 0, arena.Format("{} FPS", fps));
+	//
+	// Not thread-safe; each thread needs its own arena.
+	class FrameArena
+	{
+	public:
+		// Creates an arena with the provided initial buffer size in bytes
+		explicit FrameArena(size_t initialCapacity = 64 * 1024);
+
+		// Returns the memory resource for std::pmr containers. Allocations are valid until the next Reset.
+		std::pmr::memory_resource* GetResource() noexcept
+		{
+			return &*m_resource;
+		}
+
+		// Formats text into the arena; the returned view is valid until the next Reset
+		template<typename... Args>
+		std::string_view Format(std::format_string<Args...> format, Args&&... args)
+		{
+			const size_t size = std::formatted_size(format, std::forward<Args>(args)...);
+			auto* text = static_cast<char*>(GetResource()->allocate(size, alignof(char)));
+			std::format_to(text, format, std::forward<Args>(args)...);
+			return std::string_view(text, size);
+		}
+
+		// Releases all allocations, growing the buffer if the arena overflowed it since the last Reset
+		void Reset();
+
+		// Returns the size of the arena's buffer in bytes
+		size_t GetCapacity() const noexcept
+		{
+			return m_buffer.size();
+		}
+
+		// Returns the bytes allocated from the heap since the last Reset because the buffer was full
+		size_t GetOverflowBytes() const noexcept
+		{
+			return m_upstream.allocatedBytes;
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		FrameArena(FrameArena&) = delete;
+		FrameArena(FrameArena&&) = delete;
+		FrameArena& operator=(FrameArena&) = delete;
+		FrameArena& operator=(FrameArena&&) = delete;
+
+	private:
+		// Heap resource that counts what the arena requests once its buffer is full
+		class OverflowResource : public std::pmr::memory_resource
+		{
+		public:
+			size_t allocatedBytes = 0;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				allocatedBytes += bytes;
+				return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+			{
+				std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+			{
+				return this == &other;
+			}
+		};
+
+	private:
+		// Memory handed out before overflowing to the heap
+		std::vector<std::byte> m_buffer;
+
+		OverflowResource m_upstream;
+
+		// Recreated over a grown buffer when the arena overflows
+		std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+	};
+} // namespace engine
+} // namespace nu
\ No newline at end of file
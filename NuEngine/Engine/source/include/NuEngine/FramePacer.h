@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace nu
+{
+namespace engine
+{
+	// Paces frames to a target rate with little CPU. Frame deadlines are absolute, so oversleeping one frame doesn't
+	// push back later ones. The pacer sleeps on a high-resolution timer until a margin before the deadline, then spins
+	// for the rest. The margin adapts to the wake-up error measured over recent frames, so it stays as short as the
+	// timer allows.
+	class FramePacer
+	{
+	public:
+		FramePacer();
+		~FramePacer();
+
+		// Sets the target frame rate; zero disables pacing. Restarts the deadline sequence if the rate changed.
+		void SetTargetFramesPerSecond(uint16_t targetFramesPerSecond) noexcept;
+
+		// Waits until the next frame deadline. If the frame overran by more than a whole period, the deadlines are
+		// restarted from now instead of running several frames back-to-back to catch up.
+		void WaitForNextFrame();
+
+		// Returns how late the timer woke relative to the requested time during the last wait; zero if it didn't sleep
+		std::chrono::duration<double> GetLastWakeError() const noexcept
+		{
+			return m_lastWakeError;
+		}
+
+		// Returns how far past the deadline the last wait returned; zero if it returned on time
+		std::chrono::duration<double> GetLastDeadlineMiss() const noexcept
+		{
+			return m_lastDeadlineMiss;
+		}
+
+		// Returns the time currently spun before each deadline instead of sleeping
+		std::chrono::duration<double> GetSpinMargin() const noexcept
+		{
+			return m_spinMargin;
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		FramePacer(FramePacer&) = delete;
+		FramePacer(FramePacer&&) = delete;
+		FramePacer& operator=(FramePacer&) = delete;
+		FramePacer& operator=(FramePacer&&) = delete;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		// Sleeps until approximately the provided time
+		void SleepUntil(Clock::time_point wakeTime);
+
+		// Records a measured wake-up error and updates the spin margin from the recent history
+		void RecordWakeError(Clock::duration wakeError);
+
+	private:
+		// Number of recent wake-up errors the spin margin is derived from
+		static constexpr size_t wakeErrorHistorySize = 128;
+
+		// Waitable timer handle
+		void* m_hTimer = nullptr;
+
+		// Time between frames; zero when pacing is disabled
+		Clock::duration m_period = Clock::duration::zero();
+
+		// Deadline of the next frame
+		Clock::time_point m_deadline;
+
+		// Recent wake-up errors, oldest overwritten first
+		std::array<Clock::duration, wakeErrorHistorySize> m_wakeErrors;
+		size_t m_nextWakeErrorIndex = 0;
+
+		std::chrono::duration<double> m_spinMargin;
+		std::chrono::duration<double> m_lastWakeError = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> m_lastDeadlineMiss = std::chrono::duration<double>::zero();
+	};
+} // namespace engine
+} // namespace nu
\ No newline at end of file
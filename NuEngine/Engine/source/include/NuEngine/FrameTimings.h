@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "NuEngine/AllocationTracking.h"
+#include "NuEngine/HardwareCounters.h"
+#include "NuEngine/RenderStatistics.h"
+
+namespace nu
+{
+namespace engine
+{
+	// What the engine measured during one frame
+	struct FrameTimings
+	{
+		std::chrono::duration<double> totalFrameTime = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> tickTime = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> renderTime = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> presentTime = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> idleTime = std::chrono::duration<double>::zero();
+
+		// Number of times Game::Tick ran this frame; can be zero or several with a fixed tick rate
+		uint16_t ticks = 0;
+
+		// Number of input events consumed this frame
+		uint32_t inputEventsConsumed = 0;
+
+		// Time from reading consumed input events to the end of this frame's Present; zero if no input was consumed
+		std::chrono::duration<double> inputLatencyMin = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> inputLatencyAverage = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> inputLatencyMax = std::chrono::duration<double>::zero();
+
+		// How late the frame pacer's timer woke, and how far past the frame deadline idling ended
+		std::chrono::duration<double> wakeError = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> deadlineMiss = std::chrono::duration<double>::zero();
+
+		// Whether the overload policy skipped Render or Present this frame; skipped phases report zero time
+		bool isRenderSkipped = false;
+		bool isPresentSkipped = false;
+
+		// What this frame's Present scanned and wrote to the console; zero if Present was skipped
+		nu::console::PresentStatistics present;
+
+		// Smoothed time the terminal took to answer a cursor position request written after a frame; zero unless terminal
+		// pacing is enabled and the terminal has answered
+		std::chrono::duration<double> terminalRoundTrip = std::chrono::duration<double>::zero();
+
+		// Frame rate paced to this frame; below the target when the overload policy reduced it, zero if unlimited
+		uint16_t pacedFramesPerSecond = 0;
+
+		// Heap allocations made during each phase of this frame, indexed by FramePhase; zero unless the engine is built
+		// with NU_ENABLE_ALLOCATION_TRACKING. Allocations by jobs count toward the phase the frame loop is in.
+		std::array<AllocationCounts, framePhaseCount> allocations;
+
+		// Bytes allocated on the heap at the end of this frame, and the most ever allocated at once
+		uint64_t liveHeapBytes = 0;
+		uint64_t peakLiveHeapBytes = 0;
+
+		// Hardware counts of each phase of this frame, indexed by FramePhase; zero unless hardware counters are enabled.
+		// Counted on the frame loop's thread, except for a pipelined tick, which is counted on the simulation thread.
+		std::array<HardwareCounts, framePhaseCount> hardwareCounts;
+	};
+} // namespace engine
+} // namespace nu
@@ -28,9 +28,17 @@ namespace engine
 		// Called each frame to update the game simulation
 		virtual void Tick(std::chrono::duration<double> deltaTime) = 0;
 
-		// Called each frame to render the game
+		// Called each frame to render the game, unless the overload below is overridden
 		virtual void Render(nu::console::ConsoleRenderer& renderer) = 0;
 
+		// Called each frame to render the game. With a fixed tick rate, alpha in [0, 1) is how far the current time is
+		// between the last tick and the next one, for interpolating between simulation states; otherwise it is 1.
+		// Defaults to calling Render(renderer).
+		virtual void Render(nu::console::ConsoleRenderer& renderer, double alpha)
+		{
+			Render(renderer);
+		}
+
 		// Called when a key is pressed in Keys input mode
 		bool OnKeyDown(nu::console::Key key) override
 		{
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nu
+{
+namespace engine
+{
+	// Counters the CPU and the OS keep while code runs, which tell a phase that computes from one that waits
+	struct HardwareCounts
+	{
+		// CPU cycles the thread ran for; a phase with far fewer cycles than its duration spent the rest blocked
+		uint64_t cycles = 0;
+
+		// Page faults of the whole process, including soft faults on first touch of newly allocated memory
+		uint64_t pageFaults = 0;
+
+		HardwareCounts& operator+=(const HardwareCounts& other) noexcept
+		{
+			cycles += other.cycles;
+			pageFaults += other.pageFaults;
+			return *this;
+		}
+
+		HardwareCounts operator-(const HardwareCounts& other) const noexcept
+		{
+			return { .cycles = cycles - other.cycles, .pageFaults = pageFaults - other.pageFaults };
+		}
+	};
+
+	namespace hardwareCounters
+	{
+		// Returns true if the counters can be read; when they can't, Read always returns zero counts
+		bool IsAvailable();
+
+		// Returns the counts of the calling thread so far; subtract an earlier read on the same thread to get the counts in between
+		HardwareCounts Read() noexcept;
+
+		// Returns the fraction of the provided duration, in seconds, that the provided cycles kept a core busy
+		double GetUtilization(const HardwareCounts& counts, double seconds);
+	} // namespace hardwareCounters
+} // namespace engine
+} // namespace nu
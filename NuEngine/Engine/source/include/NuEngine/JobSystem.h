@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NuEngine/FrameArena.h"
+
+namespace nu
+{
+namespace engine
+{
+	// Tracks a group of submitted jobs. Complete once every job added to it has finished; jobs can be submitted to run
+	// after a counter completes, and JobSystem::Wait runs other jobs while waiting for one. Wait for a counter with
+	// pending jobs before destroying it.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		// Returns true when no jobs added to the counter are pending
+		bool IsComplete() const noexcept
+		{
+			return m_pendingJobs.load(std::memory_order_acquire) == 0;
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		JobCounter(JobCounter&) = delete;
+		JobCounter(JobCounter&&) = delete;
+		JobCounter& operator=(JobCounter&) = delete;
+		JobCounter& operator=(JobCounter&&) = delete;
+
+	private:
+		// Job submitted once the counter completes
+		struct Continuation
+		{
+			std::function<void()> function;
+			JobCounter* counter = nullptr;
+		};
+
+		// Number of jobs added to the counter that haven't finished
+		std::atomic<uint32_t> m_pendingJobs = 0;
+
+		// Jobs waiting for the counter to complete
+		std::mutex m_continuationsMutex;
+		std::vector<Continuation> m_continuations;
+
+		// Allow the job system to update the counter
+		friend class JobSystem;
+	};
+
+	// Work-stealing job system. Each worker thread owns a deque it pushes to and pops from at the back; idle workers
+	// steal from the front of other deques. Threads that aren't workers, such as the main thread, share one more deque.
+	class JobSystem
+	{
+	public:
+		// Starts the provided number of worker threads; zero starts one per hardware thread, less one for the main thread
+		explicit JobSystem(uint32_t workerCount = 0);
+
+		~JobSystem();
+
+		// Returns the number of worker threads
+		uint32_t GetWorkerCount() const noexcept
+		{
+			return static_cast<uint32_t>(m_workers.size());
+		}
+
+		// Submits a job; the optional counter tracks its completion
+		void Submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+		// Submits a job that runs once the dependency completes; the optional counter tracks its completion
+		void SubmitAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr);
+
+		// Runs jobs on the calling thread until the counter completes
+		void Wait(JobCounter& counter);
+
+		// Returns a scratch arena for the job running on the calling thread. Each thread has its own; it is reset when
+		// the outermost job running on the thread finishes, so allocations must not outlive the job.
+		static FrameArena& GetJobArena();
+
+		// Submits function(i) for each i in [begin, end), split into jobs of grainSize indices; a grain size of zero
+		// picks one that gives each worker a few jobs. The function is copied into each job.
+		template<typename Function>
+		void ParallelFor(size_t begin, size_t end, size_t grainSize, Function function, JobCounter& counter)
+		{
+			if (begin >= end)
+			{
+				return;
+			}
+
+			if (grainSize == 0)
+			{
+				constexpr size_t jobsPerThread = 4;
+				grainSize = std::max<size_t>((end - begin) / ((GetWorkerCount() + 1) * jobsPerThread), 1);
+			}
+
+			for (size_t start = begin; start < end; start += std::min(grainSize, end - start))
+			{
+				const size_t chunkEnd = start + std::min(grainSize, end - start);
+				Submit(
+					[function, start, chunkEnd]()
+					{
+						for (size_t i = start; i < chunkEnd; ++i)
+						{
+							function(i);
+						}
+					},
+					&counter);
+			}
+		}
+
+		// Runs function(i) for each i in [begin, end) across the workers and the calling thread, returning once all have run
+		template<typename Function>
+		void ParallelFor(size_t begin, size_t end, size_t grainSize, Function function)
+		{
+			JobCounter counter;
+			ParallelFor(begin, end, grainSize, std::move(function), counter);
+			Wait(counter);
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		JobSystem(JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(JobSystem&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+	private:
+		struct Job
+		{
+			std::function<void()> function;
+			JobCounter* counter = nullptr;
+		};
+
+		// Deque of jobs owned by one thread and stolen from by others. A ring buffer that grows by doubling, so
+		// steady-state pushes don't allocate.
+		struct alignas(64) JobQueue
+		{
+			std::mutex mutex;
+			std::vector<Job> jobs;
+
+			// Index of the oldest job, and number of queued jobs
+			size_t head = 0;
+			size_t count = 0;
+
+			// Adds a job at the back
+			void PushBack(Job&& job);
+
+			// Removes the newest job; returns false if empty
+			bool TryPopBack(Job& job);
+
+			// Removes the oldest job; returns false if empty
+			bool TryPopFront(Job& job);
+		};
+
+	private:
+		// Runs jobs until the job system is destroyed
+		void RunWorker(uint32_t workerIndex);
+
+		// Pushes a job onto the calling thread's queue and wakes a worker
+		void Push(Job&& job);
+
+		// Pops a job from the calling thread's queue, or steals one from another queue; returns false if there are none
+		bool TryTakeJob(Job& job);
+
+		// Runs a job and completes it on its counter
+		void Execute(Job& job);
+
+		// Marks one job on the counter as finished, submitting its continuations if it was the last one
+		void CompleteJob(JobCounter& counter);
+
+		// Returns the index of the queue owned by the calling thread
+		uint32_t GetQueueIndex() const noexcept;
+
+	private:
+		// One queue per worker, then the queue shared by all other threads
+		std::unique_ptr<JobQueue[]> m_queues;
+		uint32_t m_queueCount = 0;
+
+		// Number of queued jobs; workers sleep on it while it is zero
+		std::atomic<uint32_t> m_queuedJobs = 0;
+
+		// Set when the job system is being destroyed
+		std::atomic<bool> m_isStopping = false;
+
+		std::vector<std::jthread> m_workers;
+	};
+} // namespace engine
+} // namespace nu
\ No newline at end of file
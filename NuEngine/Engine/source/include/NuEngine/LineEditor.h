@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nu
+{
+namespace console
+{
+	// Single-line text editor backed by a UTF-8 gap buffer. The gap sits at the cursor, so each keystroke is applied
+	// once in amortized O(1) and the UTF-8 text never has to be rebuilt from the keystrokes that produced it.
+	class LineEditor
+	{
+	public:
+		LineEditor() = default;
+
+		// Inserts a Unicode code point at the cursor
+		void Insert(char32_t codePoint);
+
+		// Inserts UTF-8 text at the cursor
+		void Insert(std::u8string_view text);
+
+		// Removes the code point before the cursor
+		void Backspace();
+
+		// Removes the code point after the cursor
+		void Delete();
+
+		// Moves the cursor one code point to the left
+		void MoveLeft();
+
+		// Moves the cursor one code point to the right
+		void MoveRight();
+
+		// Moves the cursor to the start of the line
+		void MoveHome();
+
+		// Moves the cursor to the end of the line
+		void MoveEnd();
+
+		// Replaces the line with the previous history entry
+		void HistoryPrevious();
+
+		// Replaces the line with the next history entry, or the line being edited before history was browsed
+		void HistoryNext();
+
+		// Replaces the line with the provided text and moves the cursor to the end
+		void SetText(std::u8string_view text);
+
+		// Adds the current line to the history and clears it
+		void Commit();
+
+		// Clears the current line; history is kept
+		void Clear();
+
+		// Returns true if the line has no text
+		bool IsEmpty() const noexcept
+		{
+			return m_gapStart == 0 && m_gapEnd == m_buffer.size();
+		}
+
+		// Returns the text before the cursor
+		std::u8string_view GetTextBeforeCursor() const noexcept
+		{
+			return std::u8string_view(m_buffer.data(), m_gapStart);
+		}
+
+		// Returns the text after the cursor
+		std::u8string_view GetTextAfterCursor() const noexcept
+		{
+			return std::u8string_view(m_buffer.data() + m_gapEnd, m_buffer.size() - m_gapEnd);
+		}
+
+		// Returns the code point under the cursor, or an empty view at the end of the line
+		std::u8string_view GetCodePointAtCursor() const noexcept;
+
+		// Returns the number of code points before the cursor
+		size_t GetCursorColumn() const noexcept
+		{
+			return m_cursorColumn;
+		}
+
+		// Returns the full line as contiguous UTF-8. Rebuilt from the two halves of the gap buffer only when changed.
+		const std::u8string& GetText();
+
+	private:
+		// Ensures the gap can hold at least the requested number of bytes, growing geometrically
+		void ReserveGap(size_t bytes);
+
+		// Returns the number of bytes in the UTF-8 sequence starting with the provided lead byte
+		static size_t GetSequenceLength(char8_t leadByte) noexcept;
+
+		// Returns true if the byte continues a UTF-8 sequence
+		static bool IsContinuationByte(char8_t byte) noexcept
+		{
+			return (byte & 0b11000000) == 0b10000000;
+		}
+
+	private:
+		// Text before the cursor in [0, m_gapStart), text after the cursor in [m_gapEnd, size)
+		std::u8string m_buffer;
+		size_t m_gapStart = 0;
+		size_t m_gapEnd = 0;
+
+		// Number of code points before the cursor
+		size_t m_cursorColumn = 0;
+
+		// Contiguous copy of the line returned by GetText
+		std::u8string m_text;
+
+		// Whether m_text matches the gap buffer
+		bool m_isTextValid = true;
+
+		// Previously committed lines, oldest first
+		std::vector<std::u8string> m_history;
+
+		// Index of the history entry being shown; equal to the history size when not browsing history
+		size_t m_historyIndex = 0;
+
+		// Line being edited before history was browsed
+		std::u8string m_draft;
+	};
+} // namespace console
+} // namespace nu
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+// Set to 0 in the project's preprocessor definitions to compile out every NU_PROFILE_SCOPE. When compiled in, scopes
+// cost one relaxed load while profiling is disabled, so they can stay in production builds.
+#ifndef NU_ENABLE_PROFILING
+#define NU_ENABLE_PROFILING 1
+#endif
+
+#define NU_PROFILE_CONCAT_INNER(a, b) a##b
+#define NU_PROFILE_CONCAT(a, b) NU_PROFILE_CONCAT_INNER(a, b)
+
+#if NU_ENABLE_PROFILING
+// Records the time from here to the end of the enclosing scope under the provided name, which must be a string literal
+#define NU_PROFILE_SCOPE(name) const ::nu::engine::ProfileScope NU_PROFILE_CONCAT(nuProfileScope, __LINE__)(name)
+#else
+#define NU_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace nu
+{
+namespace console
+{
+	class ConsoleRenderer;
+}
+
+namespace engine
+{
+	class FrameArena;
+
+	// A completed profile scope
+	struct ProfileEvent
+	{
+		const char* name = nullptr;
+
+		// Ticks of the profiler's clock source, the TSC when it's invariant
+		int64_t start = 0;
+		int64_t end = 0;
+
+		// Number of enclosing scopes on the same thread
+		uint16_t depth = 0;
+
+		// Index of the thread the scope ran on, in order of each thread's first scope
+		uint16_t threadIndex = 0;
+	};
+
+	namespace profiler
+	{
+		namespace details
+		{
+			inline std::atomic<bool> isEnabled = false;
+		} // namespace details
+
+		// Returns true if profile scopes are being recorded
+		inline bool IsEnabled() noexcept
+		{
+			return details::isEnabled.load(std::memory_order_relaxed);
+		}
+
+		// Starts or stops recording profile scopes on all threads
+		void SetEnabled(bool isEnabled) noexcept;
+
+		// Names the calling thread in the overlay and exported traces
+		void SetThreadName(std::string_view name);
+	} // namespace profiler
+
+	// Records a profile event for its lifetime; use through NU_PROFILE_SCOPE. Events go into a fixed-size lock-free
+	// ring buffer owned by the recording thread, and are dropped if the ring is full.
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name)
+		{
+			if (profiler::IsEnabled())
+			{
+				Begin(name);
+			}
+		}
+
+		~ProfileScope()
+		{
+			if (m_name != nullptr)
+			{
+				End();
+			}
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		ProfileScope(ProfileScope&) = delete;
+		ProfileScope(ProfileScope&&) = delete;
+		ProfileScope& operator=(ProfileScope&) = delete;
+		ProfileScope& operator=(ProfileScope&&) = delete;
+
+	private:
+		void Begin(const char* name);
+		void End() noexcept;
+
+	private:
+		const char* m_name = nullptr;
+		int64_t m_start = 0;
+	};
+
+	// Collects the events recorded on every thread once per frame. Keeps the last frame's events for the flame-bar
+	// overlay, and a rolling history of recent events that can be exported as a Chrome trace (chrome://tracing, Perfetto).
+	class ProfileCapture
+	{
+	public:
+		ProfileCapture() = default;
+
+		// Collects events recorded since the last call; they become the last frame's events. Call at the start of each frame.
+		void BeginFrame();
+
+		// Draws the last frame's events as one row of bars per thread and scope depth, scaled to the frame's duration.
+		// Uses up to the provided number of rows at the bottom of the renderer, above the commander's row.
+		void DrawFlameBars(nu::console::ConsoleRenderer& renderer, FrameArena& arena, uint16_t maxRows);
+
+		// Writes the event history as Chrome trace JSON; returns the number of events written, or -1 on failure
+		int64_t ExportChromeTrace(const std::filesystem::path& path) const;
+
+		// Returns the number of events dropped because a thread's ring buffer was full
+		uint64_t GetDroppedEventCount() const;
+
+		// Delete copy/move construction and assignment
+	private:
+		ProfileCapture(ProfileCapture&) = delete;
+		ProfileCapture(ProfileCapture&&) = delete;
+		ProfileCapture& operator=(ProfileCapture&) = delete;
+		ProfileCapture& operator=(ProfileCapture&&) = delete;
+
+	private:
+		// Number of events kept for export; enough for a few seconds of a typically instrumented frame loop
+		static constexpr size_t historyCapacity = 1 << 16;
+
+		// Events collected at the start of this frame, sorted by thread, depth and start time
+		std::vector<ProfileEvent> m_lastFrameEvents;
+
+		// Start time of the last frame and of this one, in ticks of the profiler's clock source
+		int64_t m_lastFrameStart = 0;
+		int64_t m_frameStart = 0;
+
+		// Ring of recent events, allocated the first time profiling is enabled
+		std::vector<ProfileEvent> m_history;
+		size_t m_historyNext = 0;
+		size_t m_historySize = 0;
+	};
+} // namespace engine
+} // namespace nu
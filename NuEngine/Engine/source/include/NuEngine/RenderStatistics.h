@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace nu
+{
+namespace console
+{
+	// Per-cell work of the last Present, counted while cell statistics are enabled
+	struct CellStatistics
+	{
+		// Draws to cells during the frame, including Clear
+		uint64_t cellWrites = 0;
+
+		// Cells drawn more than once during the frame
+		uint32_t overdrawnCells = 0;
+	};
+
+	// What Present did to bring the console up to date, counted on every Present
+	struct PresentStatistics
+	{
+		// Cells compared against the previous frame, and the ones that differed and were written to the console
+		uint32_t scannedCells = 0;
+		uint32_t changedCells = 0;
+
+		// Runs of adjacent changed cells; each starts with a cursor move
+		uint32_t runs = 0;
+
+		// Bytes of output by kind: cursor moves and visibility, SGR color changes, and the characters themselves
+		uint64_t cursorBytes = 0;
+		uint64_t colorBytes = 0;
+		uint64_t textBytes = 0;
+
+		// Writes to the console and the time spent in them, which includes waiting for the terminal to accept the output.
+		// With async present, the write happens on the output thread, and this is the time of the last write it finished.
+		uint32_t writes = 0;
+		std::chrono::duration<double> writeTime = std::chrono::duration<double>::zero();
+
+		// True if async present dropped this frame because the output thread was still writing an earlier one; the
+		// next frame that isn't dropped writes the difference from what the console last received
+		bool isCoalesced = false;
+
+		// True if the output included a cursor position request asked for with RequestStatusReport
+		bool isStatusReportSent = false;
+
+		uint64_t GetTotalBytes() const noexcept
+		{
+			return cursorBytes + colorBytes + textBytes;
+		}
+	};
+} // namespace console
+} // namespace nu
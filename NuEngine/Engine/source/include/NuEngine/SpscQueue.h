@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace nu
+{
+namespace engine
+{
+	// Fixed-capacity lock-free ring buffer for exactly one producer thread and one consumer thread.
+	// Push and Pop never block or allocate; Push fails when the queue is full.
+	template<typename T, size_t Capacity>
+	class SpscQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		SpscQueue() = default;
+
+		// Attempts to push a value; returns false if the queue is full. Producer thread only.
+		bool TryPush(const T& value)
+		{
+			const size_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_cachedTail == Capacity)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head - m_cachedTail == Capacity)
+				{
+					return false;
+				}
+			}
+
+			m_slots[head & (Capacity - 1)] = value;
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Attempts to pop a value; returns false if the queue is empty. Consumer thread only.
+		bool TryPop(T& value)
+		{
+			const size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail == m_cachedHead)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail == m_cachedHead)
+				{
+					return false;
+				}
+			}
+
+			value = m_slots[tail & (Capacity - 1)];
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Returns true if there is nothing to pop. Safe to call from either thread, but only a snapshot.
+		bool IsEmpty() const noexcept
+		{
+			return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+		}
+
+		// Returns the maximum number of values the queue can hold
+		static constexpr size_t GetCapacity() noexcept
+		{
+			return Capacity;
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		SpscQueue(SpscQueue&) = delete;
+		SpscQueue(SpscQueue&&) = delete;
+		SpscQueue& operator=(SpscQueue&) = delete;
+		SpscQueue& operator=(SpscQueue&&) = delete;
+
+	private:
+		// Keep producer and consumer state on separate cache lines to avoid false sharing
+		static constexpr size_t CacheLineSize = 64;
+
+		// Next slot to write; written by the producer
+		alignas(CacheLineSize) std::atomic<size_t> m_head = 0;
+
+		// Producer's last observed value of m_tail
+		size_t m_cachedTail = 0;
+
+		// Next slot to read; written by the consumer
+		alignas(CacheLineSize) std::atomic<size_t> m_tail = 0;
+
+		// Consumer's last observed value of m_head
+		size_t m_cachedHead = 0;
+
+		// Storage for queued values
+		alignas(CacheLineSize) std::array<T, Capacity> m_slots{};
+	};
+} // namespace engine
+} // namespace nu
\ No newline at end of file
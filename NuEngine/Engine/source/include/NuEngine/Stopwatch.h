@@ -1,16 +1,24 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+
+#include "NuEngine/Clock.h"
 
 namespace nu
 {
 namespace engine
 {
+	// Measures elapsed time in ticks of a clock source, converting to durations only when asked for them
 	class Stopwatch
 	{
 	public:
+		// Measures with the default clock source; the TSC when it's invariant
 		Stopwatch();
 
+		// Measures with the provided clock source, or the steady clock if the TSC isn't available
+		explicit Stopwatch(ClockSource clockSource);
+
 		// Starts, or resumes, measuring elapsed time for an interval
 		void Start();
 
@@ -23,12 +31,15 @@ namespace engine
 		// Stops time interval measurement, resets the elapsed time to zero, and starts measuring elapsed time
 		void Restart();
 
-		// Returns the elapsed time as a duration (for use with std::chrono::duration_cast)
-		auto ElapsedDuration() const
+		// Returns the elapsed time in ticks of the stopwatch's clock source
+		int64_t ElapsedTicks() const noexcept
 		{
-			return m_isRunning ? std::chrono::high_resolution_clock::now() - m_startTime : m_endTime - m_startTime;
+			return (m_isRunning ? clock::Now(m_clockSource) : m_endTime) - m_startTime;
 		}
 
+		// Returns the elapsed time as a duration (for use with std::chrono::duration_cast)
+		std::chrono::nanoseconds ElapsedDuration() const;
+
 		// Returns the elapsed time in milliseconds
 		std::chrono::duration<double, std::milli> ElapsedMilliseconds() const;
 
@@ -38,10 +49,19 @@ namespace engine
 		// Checks if the stopwatch is running
 		bool IsRunning() const;
 
+		// Returns the clock source the stopwatch measures with
+		ClockSource GetClockSource() const noexcept
+		{
+			return m_clockSource;
+		}
+
 	private:
-		std::chrono::high_resolution_clock::time_point m_startTime;
-		std::chrono::high_resolution_clock::time_point m_endTime;
+		ClockSource m_clockSource;
+
+		// Ticks of the clock source; a start time of zero means not started since the last Reset
+		int64_t m_startTime = 0;
+		int64_t m_endTime = 0;
 		bool m_isRunning = false;
 	};
-} // namespace profiling
+} // namespace engine
 } // namespace nu
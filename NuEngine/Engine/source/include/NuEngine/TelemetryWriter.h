@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "NuEngine/FrameTimings.h"
+#include "NuEngine/SpscQueue.h"
+
+namespace nu
+{
+namespace engine
+{
+	// Records every frame's timings, and any counters the game adds, to CSV files for offline analysis. The frame loop
+	// only pushes a record into a lock-free ring buffer; a background thread formats and writes the records, starting
+	// a new file once the current one reaches the maximum size and deleting the oldest files beyond the maximum count.
+	// Records are dropped, and counted, if the writer falls a whole ring behind.
+	class TelemetryWriter
+	{
+	public:
+		// Maximum number of counters
+		static constexpr size_t maxCounters = 8;
+
+		TelemetryWriter() = default;
+		~TelemetryWriter();
+
+		// Adds a counter column and returns its index for SetCounter. Counters can only be added while stopped.
+		size_t AddCounter(std::string_view name);
+
+		// Sets a counter's value; it is recorded with every frame until set again. Safe to call from any thread.
+		void SetCounter(size_t index, double value) noexcept
+		{
+			m_counters[index].store(value, std::memory_order_relaxed);
+		}
+
+		// Sets the size at which a new file is started, and the number of files kept; zero keeps every file. Call while stopped.
+		void SetRotation(uint64_t maxFileBytes, uint32_t maxFiles) noexcept
+		{
+			m_maxFileBytes = maxFileBytes;
+			m_maxFiles = maxFiles;
+		}
+
+		// Starts writing files into the provided directory, creating it if needed; returns false if it can't be created
+		bool Start(const std::filesystem::path& directory);
+
+		// Writes any records still queued and stops the writer thread
+		void Stop();
+
+		bool IsRunning() const noexcept
+		{
+			return m_writerThread.joinable();
+		}
+
+		// Queues a frame's timings and the current counter values. Frame loop only.
+		void RecordFrame(const FrameTimings& frameTimings) noexcept;
+
+		// Returns the number of frames dropped because the queue was full
+		uint64_t GetDroppedFrameCount() const noexcept
+		{
+			return m_droppedFrames.load(std::memory_order_relaxed);
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		TelemetryWriter(TelemetryWriter&) = delete;
+		TelemetryWriter(TelemetryWriter&&) = delete;
+		TelemetryWriter& operator=(TelemetryWriter&) = delete;
+		TelemetryWriter& operator=(TelemetryWriter&&) = delete;
+
+	private:
+		struct Record
+		{
+			uint64_t frame = 0;
+			std::chrono::steady_clock::time_point time;
+			FrameTimings timings;
+			std::array<double, maxCounters> counters{};
+		};
+
+		// Enough frames for several seconds of a stalled writer at high frame rates
+		using RecordQueue = SpscQueue<Record, 2048>;
+
+		void RunWriter(std::stop_token stopToken);
+
+		// Appends a record as a CSV row
+		void AppendRow(const Record& record, std::string& output) const;
+
+		// Writes output to the current file, starting a new one if it's full; returns false if writing failed
+		bool WriteOutput(std::string& output);
+
+		// Closes the current file, if any, opens the next one and writes the header row
+		bool OpenNextFile();
+
+	private:
+		std::vector<std::string> m_counterNames;
+		std::array<std::atomic<double>, maxCounters> m_counters{};
+
+		uint64_t m_maxFileBytes = 16 * 1024 * 1024;
+		uint32_t m_maxFiles = 8;
+
+		// Allocated on Start, as it's too big to keep inline
+		std::unique_ptr<RecordQueue> m_records;
+
+		uint64_t m_nextFrame = 0;
+		std::chrono::steady_clock::time_point m_startTime;
+		std::atomic<uint64_t> m_droppedFrames = 0;
+
+		// Writer thread state
+		std::filesystem::path m_directory;
+		std::string m_sessionName;
+		uint32_t m_nextFileIndex = 0;
+		uint64_t m_currentFileBytes = 0;
+		std::ofstream m_file;
+
+		// Files written this session, oldest first
+		std::deque<std::filesystem::path> m_files;
+		std::jthread m_writerThread;
+	};
+} // namespace engine
+} // namespace nu
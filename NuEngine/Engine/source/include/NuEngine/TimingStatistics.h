@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nu
+{
+namespace engine
+{
+	// Distribution of the durations in a TimingWindow
+	struct TimingStatistics
+	{
+		// Percentiles, accurate to about 3%, and the exact maximum
+		std::chrono::duration<double> p50 = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> p95 = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> p99 = std::chrono::duration<double>::zero();
+		std::chrono::duration<double> max = std::chrono::duration<double>::zero();
+
+		// Average difference between consecutive durations; steady timings have little jitter even when slow
+		std::chrono::duration<double> jitter = std::chrono::duration<double>::zero();
+
+		// Number of durations longer than the window's budget
+		uint32_t budgetMisses = 0;
+
+		// Number of durations in the window
+		uint32_t samples = 0;
+	};
+
+	// Rolling window over the most recent durations of one timing, such as frame time. Durations are counted in a
+	// log-linear histogram with 32 buckets per power of two microseconds, so percentiles cost no sorting and the window
+	// never allocates after construction.
+	class TimingWindow
+	{
+	public:
+		// Number of durations kept by default; ten seconds at 60 frames per second
+		static constexpr size_t defaultWindowSize = 600;
+
+		TimingWindow() : TimingWindow(defaultWindowSize)
+		{
+		}
+
+		// Creates a window over the provided number of most recent durations
+		explicit TimingWindow(size_t windowSize);
+
+		// Adds a duration, evicting the oldest once the window is full
+		void AddSample(std::chrono::duration<double> duration);
+
+		// Sets the duration above which samples count as budget misses; zero disables budget misses
+		void SetBudget(std::chrono::duration<double> budget);
+
+		// Removes all durations
+		void Clear();
+
+		// Returns the distribution of the durations in the window
+		TimingStatistics GetStatistics() const;
+
+	private:
+		// Durations below this many microseconds have a bucket each; above, each power of two is split this many ways
+		static constexpr uint32_t subBucketCount = 32;
+		static constexpr uint32_t subBucketBits = 5;
+
+		// Enough buckets for any 32-bit number of microseconds
+		static constexpr size_t bucketCount = subBucketCount + (32 - subBucketBits) * subBucketCount;
+
+		static size_t GetBucketIndex(uint32_t microseconds) noexcept;
+
+		// Returns the highest duration, in microseconds, that falls into a bucket
+		static uint32_t GetBucketUpperBound(size_t bucketIndex) noexcept;
+
+		bool IsOverBudget(uint32_t microseconds) const noexcept
+		{
+			return m_budgetMicroseconds > 0 && microseconds > m_budgetMicroseconds;
+		}
+
+		// Returns the i-th oldest sample
+		uint32_t GetSample(size_t i) const noexcept
+		{
+			return m_samples[(m_nextSample + m_samples.size() - m_sampleCount + i) % m_samples.size()];
+		}
+
+	private:
+		std::array<uint32_t, bucketCount> m_buckets{};
+
+		// Ring of the samples in the window, in microseconds
+		std::vector<uint32_t> m_samples;
+		size_t m_nextSample = 0;
+		size_t m_sampleCount = 0;
+
+		// Sum of the differences between consecutive samples in the window
+		uint64_t m_totalJitter = 0;
+
+		uint32_t m_budgetMicroseconds = 0;
+		uint32_t m_budgetMisses = 0;
+	};
+} // namespace engine
+} // namespace nu
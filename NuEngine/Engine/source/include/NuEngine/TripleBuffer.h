@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace nu
+{
+namespace engine
+{
+	// Lock-free triple buffer for handing snapshots from one producer thread to one consumer thread.
+	// The producer fills the write buffer and publishes it; the consumer always reads the latest published snapshot.
+	// Neither side ever waits, and a buffer is never written while it is being read.
+	//
+	// With pipelined ticking enabled on the engine, a game fills a snapshot in Tick and reads it in Render:
+	//
+	//   void MyGame::Tick(std::chrono::duration<double> deltaTime)
+	//   {
+	//       auto& snapshot = m_snapshots.GetWriteBuffer();
+	//       ... write the full render state ...
+	//       m_snapshots.Publish();
+	//   }
+	//
+	//   void MyGame::Render(nu::console::ConsoleRenderer& renderer)
+	//   {
+	//       const auto& snapshot = m_snapshots.Read();
+	//       ... draw only from the snapshot ...
+	//   }
+	template<typename T>
+	class TripleBuffer
+	{
+	public:
+		TripleBuffer() = default;
+
+		// Returns the buffer to fill before publishing. Producer thread only.
+		// The buffer holds an older snapshot rather than the last published one, so write it in full.
+		T& GetWriteBuffer() noexcept
+		{
+			return m_buffers[m_writeIndex];
+		}
+
+		// Publishes the write buffer as the latest snapshot. Producer thread only.
+		void Publish() noexcept
+		{
+			const uint8_t previous = m_sharedIndex.exchange(m_writeIndex | PublishedBit, std::memory_order_acq_rel);
+			m_writeIndex = previous & IndexMask;
+		}
+
+		// Returns the latest published snapshot, or the previous one if nothing new was published. Consumer thread only.
+		const T& Read() noexcept
+		{
+			if (HasNewSnapshot())
+			{
+				const uint8_t previous = m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel);
+				m_readIndex = previous & IndexMask;
+			}
+
+			return m_buffers[m_readIndex];
+		}
+
+		// Returns true if a snapshot was published since the last Read
+		bool HasNewSnapshot() const noexcept
+		{
+			return (m_sharedIndex.load(std::memory_order_relaxed) & PublishedBit) != 0;
+		}
+
+		// Delete copy/move construction and assignment
+	private:
+		TripleBuffer(TripleBuffer&) = delete;
+		TripleBuffer(TripleBuffer&&) = delete;
+		TripleBuffer& operator=(TripleBuffer&) = delete;
+		TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+	private:
+		static constexpr uint8_t IndexMask = 0b011;
+		static constexpr uint8_t PublishedBit = 0b100;
+		static constexpr size_t CacheLineSize = 64;
+
+		// Buffer owned by the producer
+		alignas(CacheLineSize) uint8_t m_writeIndex = 0;
+
+		// Buffer exchanged between producer and consumer, plus whether it holds an unread snapshot
+		alignas(CacheLineSize) std::atomic<uint8_t> m_sharedIndex = 1;
+
+		// Buffer owned by the consumer
+		alignas(CacheLineSize) uint8_t m_readIndex = 2;
+
+		// Snapshot storage
+		std::array<T, 3> m_buffers{};
+	};
+} // namespace engine
+} // namespace nu
\ No newline at end of file
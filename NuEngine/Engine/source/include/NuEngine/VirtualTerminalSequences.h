@@ -1,5 +1,8 @@
 ﻿#pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <format>
 #include <iostream>
 #include <ostream>
@@ -301,6 +304,10 @@ namespace console
 				"\x1b"
 				"8"; // concat to avoid single hex number compiler interpretation
 
+			// Code: DSR (CPR)
+			// Report Cursor Position – The console replies with ESC [ <row> ; <column> R as input
+			inline constexpr std::string_view ReportPosition = "\x1b[6n";
+
 			// Code: CUU
 			// Cursor up
 			inline constexpr std::string_view MoveUp = "\x1b[1A";
@@ -523,6 +530,20 @@ namespace console
 				result += 'H';
 				return result;
 			}
+
+			// Code: CUP
+			// Cursor moves to <x>; <y> coordinate within the viewport, where <x> is the column of the <y> line
+			// Coordinates are 1-based. Appends to the output without creating temporary strings.
+			inline void SetPosition(int x, int y, std::string& output)
+			{
+				std::array<char, 32> buffer;
+				char* end = std::copy(CSI.begin(), CSI.end(), buffer.data());
+				end = std::to_chars(end, buffer.data() + buffer.size(), y).ptr;
+				*end++ = ';';
+				end = std::to_chars(end, buffer.data() + buffer.size(), x).ptr;
+				*end++ = 'H';
+				output.append(buffer.data(), end);
+			}
 		} // namespace cursor
 
 		// Tab stop sequences
@@ -1,13 +1,33 @@
 #include "Benchmark.h"
 
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <numbers>
+#include <sstream>
+
 #include "NuEngine/Assertions.h"
 #include "NuEngine/Engine.h"
 #include "NuEngine/Game.h"
+#include "NuEngine/Profiler.h"
 #include "NuEngine/VirtualTerminalSequences.h"
 
 using namespace std::literals;
 
-constexpr auto numFramesPerPhase = 500;
+constexpr auto timingBucketCount = static_cast<size_t>(nu::engine::TimingBucket::Count);
+
+// Frames between renderer resizes in the resize storm
+constexpr uint64_t resizeStormInterval = 4;
+
+// Rows of each sprite; every row is the same width
+constexpr std::array<std::string_view, 2> spriteShape = { "/o\\"sv, "\\_/"sv };
+constexpr auto spriteWidth = static_cast<uint16_t>(spriteShape[0].size());
+constexpr auto spriteHeight = static_cast<uint16_t>(spriteShape.size());
+
+// Text of the Unicode scene: accented Latin, Greek, Cyrillic, CJK, symbols and emoji
+constexpr auto unicodeText = u8"Grüße aus Zürich ★ Ελληνικά κείμενα ☕ русский текст 🙂 日本語のテキスト 🚀 café naïve déjà vu ✨ 🎮 "sv;
 
 enum class Color : uint8_t
 {
@@ -75,29 +95,257 @@ const std::array<std::string, static_cast<size_t>(Color::Size)> colors{
 	vt::color::ForegroundRGB(0, 0, 255),
 };
 
-Benchmark::Benchmark()
+namespace
 {
-	m_phaseConfigs = {
-		PhaseConfig{ 10, false }, PhaseConfig{ 30, false }, PhaseConfig{ 50, false }, PhaseConfig{ 70, false }, PhaseConfig{ 90, false },
-		PhaseConfig{ 10, true },  PhaseConfig{ 30, true },  PhaseConfig{ 50, true },  PhaseConfig{ 70, true },  PhaseConfig{ 90, true },
-	};
+	// Names of the timings in results files, in TimingBucket order
+	constexpr std::array<std::string_view, timingBucketCount> timingNames = { "frame_ms", "tick_ms", "render_ms", "present_ms", "idle_ms" };
+
+	// Returns a frame's timings in TimingBucket order
+	std::array<std::chrono::duration<double>, timingBucketCount> GetTimings(const nu::engine::FrameTimings& frameTimings)
+	{
+		return { frameTimings.totalFrameTime, frameTimings.tickTime, frameTimings.renderTime, frameTimings.presentTime, frameTimings.idleTime };
+	}
+
+	double ToMs(std::chrono::duration<double> duration)
+	{
+		return duration.count() * 1000.0;
+	}
+
+	// Parses text that is entirely a number
+	template<typename T>
+	bool ParseNumber(std::string_view text, T& value)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc{} && end == text.data() + text.size();
+	}
+
+	// Finds the number following a key, starting at offset, in JSON written by Benchmark::WriteResults. Moves offset past the number.
+	std::optional<double> FindNumber(std::string_view json, std::string_view key, size_t& offset)
+	{
+		const auto quotedKey = std::format("\"{}\":", key);
+		const auto keyOffset = json.find(quotedKey, offset);
+		if (keyOffset == std::string_view::npos)
+		{
+			return std::nullopt;
+		}
+
+		const auto numberOffset = json.find_first_not_of(' ', keyOffset + quotedKey.size());
+		if (numberOffset == std::string_view::npos)
+		{
+			return std::nullopt;
+		}
+
+		double value = 0.0;
+		const auto [end, error] = std::from_chars(json.data() + numberOffset, json.data() + json.size(), value);
+		if (error != std::errc{})
+		{
+			return std::nullopt;
+		}
+
+		offset = static_cast<size_t>(end - json.data());
+		return value;
+	}
+} // namespace
+
+/*static*/ std::vector<Benchmark::PhaseConfig> Benchmark::CreatePhaseConfigs()
+{
+	std::vector<PhaseConfig> phaseConfigs;
+	for (const bool renderColor : { false, true })
+	{
+		for (const uint8_t changePercent : { 10, 30, 50, 70, 90 })
+		{
+			phaseConfigs.push_back(PhaseConfig{
+				.name = std::format("{}_{}", renderColor ? "symbols_colors" : "symbols", changePercent),
+				.description = std::format("{}% of symbols {}change each frame", changePercent, renderColor ? "and colors " : ""),
+				.changePercent = changePercent,
+				.renderColor = renderColor });
+		}
+	}
+
+	phaseConfigs.push_back(PhaseConfig{ .name = "scroll", .description = "Log scrolling up a line each frame", .workload = Workload::Scroll });
+	phaseConfigs.push_back(PhaseConfig{ .name = "hud_sparse", .description = "Static scene under a HUD that changes", .workload = Workload::SparseHud });
+	phaseConfigs.push_back(PhaseConfig{ .name = "unicode_text", .description = "UTF-8 and emoji text scrolling sideways", .workload = Workload::Unicode });
+	phaseConfigs.push_back(PhaseConfig{ .name = "rgb_gradient", .description = "24-bit color gradient shifting each frame", .workload = Workload::Gradient });
+	phaseConfigs.push_back(PhaseConfig{ .name = "box_ui", .description = "Box-drawn panels, table and progress bars", .workload = Workload::BoxDrawing });
+	phaseConfigs.push_back(PhaseConfig{ .name = "sprites", .description = "Small sprites moving over an empty screen", .workload = Workload::Sprites });
+	phaseConfigs.push_back(PhaseConfig{
+		.name = "resize_storm",
+		.description = "50% of symbols and colors change, resized often",
+		.workload = Workload::ResizeStorm,
+		.changePercent = 50,
+		.renderColor = true });
+	return phaseConfigs;
+}
+
+/*static*/ std::optional<Benchmark::Options> Benchmark::ParseCommandLine(std::span<char* const> args, std::string& error)
+{
+	Options options;
+	error.clear();
+
+	const auto phaseCount = CreatePhaseConfigs().size();
+	for (size_t i = 0; i < args.size(); ++i)
+	{
+		const std::string_view arg = args[i];
+		if (arg == "--help" || arg == "-h")
+		{
+			return std::nullopt;
+		}
+
+		if (arg == "--unattended")
+		{
+			options.isUnattended = true;
+			continue;
+		}
+
+		// Every other argument takes a value
+		if (i + 1 == args.size())
+		{
+			error = std::format("Missing value for {}", arg);
+			return std::nullopt;
+		}
+
+		const std::string_view value = args[++i];
+		bool isValid = true;
+		if (arg == "--size")
+		{
+			const auto separator = value.find('x');
+			isValid = separator != std::string_view::npos && ParseNumber(value.substr(0, separator), options.width) &&
+					  ParseNumber(value.substr(separator + 1), options.height) && options.width > 0 && options.height > 0;
+		}
+		else if (arg == "--seed")
+		{
+			isValid = ParseNumber(value, options.seed);
+		}
+		else if (arg == "--phases")
+		{
+			options.phases.clear();
+			size_t start = 0;
+			while (isValid && start <= value.size())
+			{
+				const auto end = std::min(value.find(',', start), value.size());
+				size_t phase = 0;
+				isValid = ParseNumber(value.substr(start, end - start), phase) && phase >= 1 && phase <= phaseCount;
+				options.phases.push_back(phase);
+				start = end + 1;
+			}
+		}
+		else if (arg == "--frames")
+		{
+			isValid = ParseNumber(value, options.framesPerPhase) && options.framesPerPhase > 0;
+		}
+		else if (arg == "--output")
+		{
+			options.resultsPath = value;
+			options.isUnattended = true;
+		}
+		else if (arg == "--baseline")
+		{
+			options.baselinePath = value;
+			options.isUnattended = true;
+		}
+		else if (arg == "--threshold")
+		{
+			isValid = ParseNumber(value, options.regressionThreshold) && options.regressionThreshold >= 0.0;
+		}
+		else
+		{
+			error = std::format("Unknown argument {}", arg);
+			return std::nullopt;
+		}
+
+		if (!isValid)
+		{
+			error = std::format("Invalid value for {}: {}", arg, value);
+			return std::nullopt;
+		}
+	}
+
+	return options;
+}
+
+/*static*/ std::string Benchmark::GetUsage()
+{
+	return std::format(
+		"Usage: Games [options]\n"
+		"  --size WxH         Renderer size in characters, which may exceed the window, such as 1000x300; defaults to the window size\n"
+		"  --seed N           Seed for the random symbols and colors; defaults to 42\n"
+		"  --phases N,N,...   Phases to run, numbered 1 to {}; defaults to all of them\n"
+		"  --frames N         Frames measured per phase; defaults to 500\n"
+		"  --unattended       Skips the countdown and results screen, and exits once done\n"
+		"  --output FILE      Writes JSON results to FILE; implies --unattended\n"
+		"  --baseline FILE    Compares against the JSON results of an earlier run; implies --unattended\n"
+		"  --threshold PCT    How many percent slower than the baseline counts as a regression; defaults to 10\n"
+		"Exit codes: {} success, {} regression, {} invalid arguments or unreadable files\n",
+		CreatePhaseConfigs().size(),
+		exitCodeSuccess,
+		exitCodeRegression,
+		exitCodeError);
+}
+
+Benchmark::Benchmark(const Options& options) : m_options(options), m_rng(options.seed)
+{
+	InitializeScenes();
+
+	auto phaseConfigs = CreatePhaseConfigs();
+	if (m_options.phases.empty())
+	{
+		m_phaseConfigs = std::move(phaseConfigs);
+		return;
+	}
+
+	for (const auto phase : m_options.phases)
+	{
+		VerifyElseCrash(phase >= 1 && phase <= phaseConfigs.size());
+		m_phaseConfigs.push_back(phaseConfigs[phase - 1]);
+	}
+}
+
+void Benchmark::InitializeScenes()
+{
+	// Colors around the hue wheel, created once so drawing the gradient doesn't format them every frame
+	m_gradientColors.resize(256);
+	for (size_t i = 0; i < m_gradientColors.size(); ++i)
+	{
+		auto channel = [i, count = m_gradientColors.size()](double offset)
+		{
+			const double angle = 2.0 * std::numbers::pi * (static_cast<double>(i) / count + offset);
+			return static_cast<uint8_t>(std::lround(127.5 * (1.0 + std::sin(angle))));
+		};
+		m_gradientColors[i] = vt::color::BackgroundRGB(channel(0.0), channel(1.0 / 3.0), channel(2.0 / 3.0));
+	}
+
+	auto [codePoint, remainingText] = ConsoleRenderer::ReadNextU8Char(unicodeText);
+	while (!codePoint.empty())
+	{
+		m_unicodeCodePoints.push_back(std::move(codePoint));
+		std::tie(codePoint, remainingText) = ConsoleRenderer::ReadNextU8Char(remainingText);
+	}
 }
 
 void Benchmark::BeginPlay()
 {
+	// The renderer takes the requested size at the start of the first frame
+	if (m_options.width > 0 && m_options.height > 0)
+	{
+		GetEngine()->SetDesiredRendererSize(m_options.width, m_options.height);
+	}
+
+	m_jobWorkerCount = GetEngine()->GetJobSystem().GetWorkerCount();
 	Restart();
 }
 
 void Benchmark::Restart()
 {
 	GetEngine()->SetTargetFramesPerSecond(60);
+	GetEngine()->SetRenderMode(nu::engine::RenderMode::Continuous);
 
 	auto [width, height] = GetEngine()->GetRendererSize();
 	m_noise.resize(width * height);
 	m_width = width;
 	m_height = height;
 
-	// Seed noise with random characters and colors
+	// Seed noise with random characters and colors, the same ones every run
+	m_rng.seed(m_options.seed);
 	std::uniform_int_distribution charDistribution{ static_cast<int>('0'), static_cast<int>('z') };
 	std::uniform_int_distribution colorDistribution{ 0, static_cast<int>(Color::Size) - 1 };
 	for (auto& [c, col] : m_noise)
@@ -109,6 +357,21 @@ void Benchmark::Restart()
 	// Store the original noise for subsequent test phases
 	m_noiseOriginal = m_noise;
 
+	// Scatter about one sprite per forty cells, at random positions and speeds
+	std::uniform_real_distribution xDistribution{ 0.0f, static_cast<float>(std::max(width - spriteWidth, 0)) };
+	std::uniform_real_distribution yDistribution{ 0.0f, static_cast<float>(std::max(height - spriteHeight, 0)) };
+	std::uniform_real_distribution velocityDistribution{ -1.0f, 1.0f };
+	m_sprites.resize(std::max<size_t>(m_noise.size() / 40, 1));
+	for (auto& sprite : m_sprites)
+	{
+		sprite.x = xDistribution(m_rng);
+		sprite.y = yDistribution(m_rng);
+		sprite.velocityX = velocityDistribution(m_rng);
+		sprite.velocityY = velocityDistribution(m_rng) / 2.0f;
+		sprite.color = static_cast<uint8_t>(colorDistribution(m_rng));
+	}
+	m_spritesOriginal = m_sprites;
+
 	// Reset state
 	m_accruedTime = 0us;
 	m_currentFrame = 0;
@@ -120,7 +383,7 @@ void Benchmark::Restart()
 	for (auto& frameTimings : m_phaseFrameTimings)
 	{
 		frameTimings.clear();
-		frameTimings.reserve(numFramesPerPhase);
+		frameTimings.reserve(m_options.framesPerPhase);
 	}
 
 	// Invalidate any results
@@ -138,8 +401,12 @@ void Benchmark::Tick(std::chrono::duration<double> deltaTime)
 		m_accruedTime = 0us;
 		m_currentFrame = 0;
 		m_noise = m_noiseOriginal;
+		m_sprites = m_spritesOriginal;
 		++m_phase;
 
+		// Undo any resizing by a resize storm
+		GetEngine()->SetDesiredRendererSize(m_width, m_height);
+
 		if (m_phase >= 0 && m_phase < m_phaseConfigs.size())
 		{
 			// Disable framerate limit during test phases
@@ -155,7 +422,7 @@ void Benchmark::Tick(std::chrono::duration<double> deltaTime)
 	if (m_phase == -1)
 	{
 		m_accruedTime += std::chrono::duration_cast<std::chrono::microseconds>(deltaTime);
-		if (m_accruedTime < 3s)
+		if (!m_options.isUnattended && m_accruedTime < 3s)
 		{
 			return;
 		}
@@ -165,19 +432,28 @@ void Benchmark::Tick(std::chrono::duration<double> deltaTime)
 
 	if (m_phase == m_phaseConfigs.size())
 	{
-		if (m_phaseResults.empty())
+		// Results only need computing once
+		if (!m_phaseResults.empty())
 		{
-			m_phaseResults.resize(m_phaseConfigs.size());
+			return;
 		}
 
+		m_phaseResults.resize(m_phaseConfigs.size());
+
 		VerifyElseCrash(m_phaseFrameTimings.size() == m_phaseResults.size());
 		for (auto i = 0; i < m_phaseResults.size(); ++i)
 		{
 			auto& phaseResult = m_phaseResults[i];
 			auto& phaseFrameTimings = m_phaseFrameTimings[i];
 			phaseResult.frames = phaseFrameTimings.size();
+			std::vector<nu::engine::TimingWindow> timingWindows(timingBucketCount, nu::engine::TimingWindow(std::max<size_t>(phaseFrameTimings.size(), 1)));
 			for (const auto& frameTime : phaseFrameTimings)
 			{
+				const auto timings = GetTimings(frameTime);
+				for (size_t bucket = 0; bucket < timingBucketCount; ++bucket)
+				{
+					timingWindows[bucket].AddSample(timings[bucket]);
+				}
 				phaseResult.averageFrameTimings.totalFrameTime += frameTime.totalFrameTime;
 				phaseResult.averageFrameTimings.tickTime += frameTime.tickTime;
 				phaseResult.averageFrameTimings.renderTime += frameTime.renderTime;
@@ -189,7 +465,20 @@ void Benchmark::Tick(std::chrono::duration<double> deltaTime)
 			phaseResult.averageFrameTimings.renderTime /= static_cast<double>(phaseResult.frames);
 			phaseResult.averageFrameTimings.presentTime /= static_cast<double>(phaseResult.frames);
 			phaseResult.averageFrameTimings.idleTime /= static_cast<double>(phaseResult.frames);
+			for (size_t bucket = 0; bucket < timingBucketCount; ++bucket)
+			{
+				phaseResult.statistics[bucket] = timingWindows[bucket].GetStatistics();
+			}
+		}
+
+		if (m_options.isUnattended)
+		{
+			FinishUnattendedRun();
+			return;
 		}
+
+		// The results screen is static, so only redraw it when something changes
+		GetEngine()->SetRenderMode(nu::engine::RenderMode::OnDemand);
 		return;
 	}
 
@@ -199,24 +488,67 @@ void Benchmark::Tick(std::chrono::duration<double> deltaTime)
 	}
 
 	++m_currentFrame;
-	for (auto i = 0u; i < m_noise.size(); ++i)
+
+	NU_PROFILE_SCOPE("Benchmark::UpdateScene");
+
+	const auto& phaseConfig = m_phaseConfigs[m_phase];
+	if (phaseConfig.workload == Workload::ResizeStorm && m_currentFrame % resizeStormInterval == 0)
 	{
-		if ((m_currentFrame + i) % 100 >= m_phaseConfigs[m_phase].changePercent)
-		{
-			// Don't change the current noise entry
-			continue;
-		}
+		// Alternate between the full size and three quarters of it; the renderer resizes at the start of the next frame
+		const bool shouldShrink = m_currentFrame / resizeStormInterval % 2 == 1;
+		GetEngine()->SetDesiredRendererSize(
+			shouldShrink ? std::max<uint16_t>(m_width * 3 / 4, 1) : m_width,
+			shouldShrink ? std::max<uint16_t>(m_height * 3 / 4, 1) : m_height);
+	}
 
-		// Increment the character and color
-		auto& [c, col] = m_noise[i];
-		if (++c > 'z')
+	if (phaseConfig.workload == Workload::Noise || phaseConfig.workload == Workload::ResizeStorm)
+	{
+		// Every noise entry is independent, so spread them across the job system's workers
+		const auto changePercent = phaseConfig.changePercent;
+		GetEngine()->GetJobSystem().ParallelFor(
+			0,
+			m_noise.size(),
+			0,
+			[this, changePercent](size_t i)
+			{
+				if ((m_currentFrame + i) % 100 >= changePercent)
+				{
+					// Don't change the current noise entry
+					return;
+				}
+
+				// Increment the character and color
+				auto& [c, col] = m_noise[i];
+				if (++c > 'z')
+				{
+					c = '0';
+				}
+				col = (col + 1) % colors.size();
+			});
+	}
+	else if (phaseConfig.workload == Workload::Sprites)
+	{
+		// Sprites move a fixed distance each frame, so every run draws the same frames
+		const auto maxX = static_cast<float>(std::max(m_width - spriteWidth, 0));
+		const auto maxY = static_cast<float>(std::max(m_height - spriteHeight, 0));
+		for (auto& sprite : m_sprites)
 		{
-			c = '0';
+			sprite.x += sprite.velocityX;
+			sprite.y += sprite.velocityY;
+			if (sprite.x < 0.0f || sprite.x > maxX)
+			{
+				sprite.velocityX = -sprite.velocityX;
+				sprite.x = std::clamp(sprite.x, 0.0f, maxX);
+			}
+			if (sprite.y < 0.0f || sprite.y > maxY)
+			{
+				sprite.velocityY = -sprite.velocityY;
+				sprite.y = std::clamp(sprite.y, 0.0f, maxY);
+			}
 		}
-		col = (col + 1) % colors.size();
 	}
 
-	if (m_currentFrame > numFramesPerPhase)
+	if (m_currentFrame > m_options.framesPerPhase)
 	{
 		incrementPhase();
 		return;
@@ -225,28 +557,24 @@ void Benchmark::Tick(std::chrono::duration<double> deltaTime)
 
 void Benchmark::Render(nu::console::ConsoleRenderer& renderer)
 {
+	// Text only needs to last until the frame is presented
+	auto& arena = GetEngine()->GetFrameArena();
+
 	if (m_phase == -1)
 	{
 		uint16_t y = 0;
-		auto charactersLabel = std::format("{}x{}"sv, m_width, m_height);
+		auto charactersLabel = arena.Format("{}x{}"sv, m_width, m_height);
 		renderer.DrawString(0, y, charactersLabel, vt::color::ForegroundBrightCyan);
 		renderer.DrawString(charactersLabel.size(), y++, " characters rendered each frame."sv);
-		renderer.DrawString(0, y++, std::format("Benchmark will simulate/render {} frames of random symbols and colors:"sv, numFramesPerPhase));
+		renderer.DrawString(0, y++, arena.Format("Benchmark will simulate/render {} frames of each scene:"sv, m_options.framesPerPhase));
 		for (int i = 0; i < m_phaseConfigs.size(); ++i)
 		{
-			renderer.DrawString(
-				0,
-				y++,
-				std::format(
-					"    Test phase {:>2} - {}% of symbols {}change each frame"sv,
-					i + 1,
-					m_phaseConfigs[i].changePercent,
-					m_phaseConfigs[i].renderColor ? "and colors " : ""));
+			renderer.DrawString(0, y++, arena.Format("    Test phase {:>2} - {}"sv, i + 1, m_phaseConfigs[i].description));
 		}
 		renderer.DrawString(
 			0,
 			++y,
-			std::format("Starting in {} seconds...", std::chrono::duration_cast<std::chrono::seconds>(3s - m_accruedTime).count()),
+			arena.Format("Starting in {} seconds...", std::chrono::duration_cast<std::chrono::seconds>(3s - m_accruedTime).count()),
 			vt::color::ForegroundBrightYellow);
 		return;
 	}
@@ -260,96 +588,322 @@ void Benchmark::Render(nu::console::ConsoleRenderer& renderer)
 
 		uint16_t y = 0;
 		renderer.DrawString(0, y++, "Benchmark complete."sv);
-		auto charactersLabel = std::format("{}x{}"sv, m_width, m_height);
+		auto charactersLabel = arena.Format("{}x{}"sv, m_width, m_height);
 		renderer.DrawString(0, y, charactersLabel, vt::color::ForegroundBrightCyan);
 		renderer.DrawString(charactersLabel.size(), y++, " characters rendered each frame."sv);
 
-		auto drawResults = [&y, &renderer](uint16_t x, const PhaseResult& phaseResult)
+		auto drawResults = [&y, &renderer, &arena](uint16_t x, const PhaseResult& phaseResult)
 		{
 			auto toMs = [](const auto& duration) { return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(duration).count(); };
 			constexpr auto x2 = ("    Average present time: "sv).size();
 			renderer.DrawString(x, y, "    Total frames: "sv, vt::color::ForegroundWhite);
-			renderer.DrawString(x + x2, y++, std::format("{:>7}", phaseResult.frames), vt::color::ForegroundBrightWhite);
+			renderer.DrawString(x + x2, y++, arena.Format("{:>7}", phaseResult.frames), vt::color::ForegroundBrightWhite);
 			renderer.DrawString(x, y, "    Average frame time:   "sv, vt::color::ForegroundWhite);
-			renderer.DrawString(x + x2, y++, std::format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.totalFrameTime)), vt::color::ForegroundBrightWhite);
+			renderer.DrawString(x + x2, y, arena.Format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.totalFrameTime)), vt::color::ForegroundBrightWhite);
+			renderer.DrawString(x + x2 + 8, y++, arena.Format("p99 {:>5.2f}ms", toMs(phaseResult.GetStatistics(nu::engine::TimingBucket::Frame).p99)), vt::color::ForegroundWhite);
 			renderer.DrawString(x, y, "    Average tick time:    "sv, vt::color::ForegroundWhite);
-			renderer.DrawString(x + x2, y++, std::format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.tickTime)), vt::color::ForegroundBrightWhite);
+			renderer.DrawString(x + x2, y++, arena.Format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.tickTime)), vt::color::ForegroundBrightWhite);
 			renderer.DrawString(x, y, "    Average render time:  "sv, vt::color::ForegroundWhite);
-			renderer.DrawString(x + x2, y++, std::format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.renderTime)), vt::color::ForegroundBrightWhite);
+			renderer.DrawString(x + x2, y++, arena.Format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.renderTime)), vt::color::ForegroundBrightWhite);
 			renderer.DrawString(x, y, "    Average present time: "sv, vt::color::ForegroundWhite);
-			renderer.DrawString(x + x2, y++, std::format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.presentTime)), vt::color::ForegroundBrightYellow);
+			renderer.DrawString(x + x2, y, arena.Format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.presentTime)), vt::color::ForegroundBrightYellow);
+			renderer.DrawString(x + x2 + 8, y++, arena.Format("p99 {:>5.2f}ms", toMs(phaseResult.GetStatistics(nu::engine::TimingBucket::Present).p99)), vt::color::ForegroundWhite);
 			renderer.DrawString(x, y, "    Average idle time:    "sv, vt::color::ForegroundWhite);
-			renderer.DrawString(x + x2, y++, std::format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.idleTime)), vt::color::ForegroundBrightWhite);
+			renderer.DrawString(x + x2, y++, arena.Format("{:>5.2f}ms", toMs(phaseResult.averageFrameTimings.idleTime)), vt::color::ForegroundBrightWhite);
 		};
 
-		constexpr auto resultsPerColumn = 5;
-		VerifyElseCrash(m_phaseResults.size() <= 2 * resultsPerColumn);
-
-		uint16_t yStart = y;
-		for (int i = 0; i < m_phaseConfigs.size() && i < resultsPerColumn; ++i)
-		{
-			++y;
-			renderer.DrawString(
-				0,
-				y++,
-				std::format(
-					"Test {} - {}% of symbols {}change each frame"sv,
-					i + 1,
-					m_phaseConfigs[i].changePercent,
-					m_phaseConfigs[i].renderColor ? "and colors " : ""));
-			drawResults(0, m_phaseResults[i]);
-		}
-
-		y = yStart;
-		for (int i = resultsPerColumn; i < m_phaseConfigs.size(); ++i)
-		{
-			constexpr auto labelLen = "Test  5- 90% of symbols change each frame"sv.size();
-			auto x = std::max(static_cast<uint16_t>(labelLen) + 4, renderer.GetWidth() / 2);
-			++y;
-			renderer.DrawString(
-				x,
-				y++,
-				std::format(
-					"Test {} - {}% of symbols {}change each frame"sv,
-					i + 1,
-					m_phaseConfigs[i].changePercent,
-					m_phaseConfigs[i].renderColor ? "and colors " : ""));
+		// Results fill as many columns as they need, each as tall as fits on screen
+		constexpr uint16_t resultHeight = 8;
+		constexpr uint16_t columnWidth = 48;
+		const uint16_t yStart = y;
+		const int resultsPerColumn = std::max(1, (renderer.GetHeight() - yStart) / resultHeight);
+		for (int i = 0; i < m_phaseConfigs.size(); ++i)
+		{
+			const auto x = static_cast<uint16_t>(i / resultsPerColumn * columnWidth);
+			y = static_cast<uint16_t>(yStart + i % resultsPerColumn * resultHeight + 1);
+			const auto label = arena.Format("Test {} - {}"sv, i + 1, m_phaseConfigs[i].description);
+			renderer.DrawString(x, y++, label.substr(0, columnWidth - 2));
 			drawResults(x, m_phaseResults[i]);
 		}
 		return;
 	}
 
-	auto width = renderer.GetWidth();
-	for (auto i = 0u; i < m_noise.size(); ++i)
 	{
-		const auto& [c, col] = m_noise[i];
-		renderer.DrawChar(i % width, i / width, c, m_phaseConfigs[m_phase].renderColor ? colors[col] : vt::color::ForegroundWhite);
+		NU_PROFILE_SCOPE("Benchmark::DrawScene");
+		switch (m_phaseConfigs[m_phase].workload)
+		{
+			case Workload::Noise:
+			case Workload::ResizeStorm:
+				RenderNoise(renderer);
+				break;
+			case Workload::Scroll:
+				RenderScroll(renderer);
+				break;
+			case Workload::SparseHud:
+				RenderSparseHud(renderer);
+				break;
+			case Workload::Unicode:
+				RenderUnicode(renderer);
+				break;
+			case Workload::Gradient:
+				RenderGradient(renderer);
+				break;
+			case Workload::BoxDrawing:
+				RenderBoxDrawing(renderer);
+				break;
+			case Workload::Sprites:
+				RenderSprites(renderer);
+				break;
+		}
 	}
 
 	uint16_t y = 0;
 	constexpr auto x = ("Present time: "sv).size();
 	renderer.DrawString(0, y, "Test phase:   "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>7}", m_phase + 1), vt::color::ForegroundBrightYellow);
-	renderer.DrawString(0, y, "Entropy:      "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>6}%", m_phaseConfigs[m_phase].changePercent), vt::color::ForegroundBrightBlue);
+	renderer.DrawString(x, y++, arena.Format("{:>7}", m_phase + 1), vt::color::ForegroundBrightYellow);
+	if (m_phaseConfigs[m_phase].workload == Workload::Noise || m_phaseConfigs[m_phase].workload == Workload::ResizeStorm)
+	{
+		renderer.DrawString(0, y, "Entropy:      "sv, vt::color::ForegroundWhite);
+		renderer.DrawString(x, y++, arena.Format("{:>6}%", m_phaseConfigs[m_phase].changePercent), vt::color::ForegroundBrightBlue);
+	}
+	else
+	{
+		renderer.DrawString(0, y, "Scene:        "sv, vt::color::ForegroundWhite);
+		renderer.DrawString(x, y++, m_phaseConfigs[m_phase].name, vt::color::ForegroundBrightBlue);
+	}
 	renderer.DrawString(0, y, "Frame:        "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>7}", m_currentFrame), vt::color::ForegroundBrightCyan);
+	renderer.DrawString(x, y++, arena.Format("{:>7}", m_currentFrame), vt::color::ForegroundBrightCyan);
 	renderer.DrawString(0, y, "FPS:          "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>7}", std::round(1.0f / GetEngine()->GetLastFrameTime().count())), vt::color::ForegroundBrightGreen);
+	renderer.DrawString(x, y++, arena.Format("{:>7}", std::round(1.0f / GetEngine()->GetLastFrameTime().count())), vt::color::ForegroundBrightGreen);
 	renderer.DrawString(0, y, "Frame time:   "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>5.2f}ms", GetEngine()->GetLastFrameTimeMs().count()), vt::color::ForegroundBrightWhite);
+	renderer.DrawString(x, y++, arena.Format("{:>5.2f}ms", GetEngine()->GetLastFrameTimeMs().count()), vt::color::ForegroundBrightWhite);
 	renderer.DrawString(0, y, "Tick time:    "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>5.2f}ms", GetEngine()->GetLastTickTimeMs().count()), vt::color::ForegroundBrightWhite);
+	renderer.DrawString(x, y++, arena.Format("{:>5.2f}ms", GetEngine()->GetLastTickTimeMs().count()), vt::color::ForegroundBrightWhite);
 	renderer.DrawString(0, y, "Render time:  "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>5.2f}ms", GetEngine()->GetLastRenderTimeMs().count()), vt::color::ForegroundBrightWhite);
+	renderer.DrawString(x, y++, arena.Format("{:>5.2f}ms", GetEngine()->GetLastRenderTimeMs().count()), vt::color::ForegroundBrightWhite);
 	renderer.DrawString(0, y, "Present time: "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>5.2f}ms", GetEngine()->GetLastPresentTimeMs().count()), vt::color::ForegroundBrightWhite);
+	renderer.DrawString(x, y++, arena.Format("{:>5.2f}ms", GetEngine()->GetLastPresentTimeMs().count()), vt::color::ForegroundBrightWhite);
 	renderer.DrawString(0, y, "Idle time:    "sv, vt::color::ForegroundWhite);
-	renderer.DrawString(x, y++, std::format("{:>5.2f}ms", GetEngine()->GetLastIdleTimeMs().count()), vt::color::ForegroundBrightWhite);
+	renderer.DrawString(x, y++, arena.Format("{:>5.2f}ms", GetEngine()->GetLastIdleTimeMs().count()), vt::color::ForegroundBrightWhite);
+}
+
+void Benchmark::RenderNoise(nu::console::ConsoleRenderer& renderer)
+{
+	// Drawn at the full size even while a resize storm has shrunk the renderer, which ignores what falls outside
+	const bool renderColor = m_phaseConfigs[m_phase].renderColor;
+	for (size_t i = 0; i < m_noise.size(); ++i)
+	{
+		const auto& [c, col] = m_noise[i];
+		renderer.DrawChar(i % m_width, i / m_width, c, renderColor ? colors[col] : vt::color::ForegroundWhite);
+	}
+}
+
+void Benchmark::RenderScroll(nu::console::ConsoleRenderer& renderer)
+{
+	struct LogLevel
+	{
+		std::string_view label;
+		std::string_view color;
+	};
+
+	constexpr std::array logLevels = {
+		LogLevel{ "INFO "sv, vt::color::ForegroundWhite },
+		LogLevel{ "DEBUG"sv, vt::color::ForegroundBrightBlack },
+		LogLevel{ "WARN "sv, vt::color::ForegroundBrightYellow },
+		LogLevel{ "ERROR"sv, vt::color::ForegroundBrightRed },
+	};
+
+	constexpr std::array messages = {
+		"Loaded chunk 12 from disk"sv,
+		"Player entered the northern region"sv,
+		"Glyph cache miss; rebuilding atlas"sv,
+		"Frame took longer than its budget"sv,
+		"Connection to server re-established after 2 retries"sv,
+		"Spawned 12 entities near the player"sv,
+		"Autosave complete"sv,
+	};
+
+	// Every line moves up a row each frame, as if a new line was appended at the bottom
+	auto& arena = GetEngine()->GetFrameArena();
+	for (uint16_t y = 0; y < m_height; ++y)
+	{
+		const uint64_t line = m_currentFrame + y;
+		const auto& logLevel = logLevels[line % 13 == 0 ? 3 : line % 5 == 0 ? 2 : line % 3 == 0 ? 1 : 0];
+		const auto prefix = arena.Format("{:>10} {} "sv, line, logLevel.label);
+		renderer.DrawString(0, y, prefix, vt::color::ForegroundBrightBlack);
+		renderer.DrawString(prefix.size(), y, messages[line % messages.size()], logLevel.color);
+	}
+}
+
+void Benchmark::RenderSparseHud(nu::console::ConsoleRenderer& renderer)
+{
+	// Terrain that never changes, so only the HUD differs from the last frame
+	constexpr auto terrain = " .,:;~-=+*"sv;
+	for (uint16_t y = 0; y < m_height; ++y)
+	{
+		for (uint16_t x = 0; x < m_width; ++x)
+		{
+			renderer.DrawChar(x, y, terrain[(x * 31 + y * 17 + x * y % 7) % terrain.size()], vt::color::ForegroundGreen);
+		}
+	}
+
+	constexpr uint16_t hudWidth = 28;
+	constexpr uint16_t hudHeight = 5;
+	constexpr auto hudRow = "                            "sv;
+	static_assert(hudRow.size() == hudWidth);
+	const uint16_t hudX = m_width > hudWidth ? m_width - hudWidth : 0;
+	for (uint16_t y = 0; y < hudHeight; ++y)
+	{
+		renderer.DrawString(hudX, y, hudRow, vt::color::ForegroundBrightWhite, vt::color::BackgroundBlue);
+	}
+
+	auto& arena = GetEngine()->GetFrameArena();
+	const auto health = static_cast<size_t>(10 - m_currentFrame / 10 % 11);
+	renderer.DrawString(hudX + 2, 1, arena.Format("Score  {:>12}"sv, m_currentFrame * 25), vt::color::ForegroundBrightWhite, vt::color::BackgroundBlue);
+	renderer.DrawString(hudX + 2, 2, arena.Format("Health [{:<10}]"sv, "##########"sv.substr(0, health)), vt::color::ForegroundBrightRed, vt::color::BackgroundBlue);
+	renderer.DrawString(hudX + 2, 3, arena.Format("Time   {:>11.2f}s"sv, m_currentFrame / 60.0), vt::color::ForegroundBrightWhite, vt::color::BackgroundBlue);
+}
+
+void Benchmark::RenderUnicode(nu::console::ConsoleRenderer& renderer)
+{
+	// Each row starts further into the text, and moves a code point to the left each frame. Most terminals draw
+	// emoji and CJK two columns wide, while the renderer gives every code point one cell, so rows overhang.
+	for (uint16_t y = 0; y < m_height; ++y)
+	{
+		m_textRow.clear();
+		const size_t start = m_currentFrame + y * 7;
+		for (uint16_t x = 0; x < m_width; ++x)
+		{
+			m_textRow += m_unicodeCodePoints[(start + x) % m_unicodeCodePoints.size()];
+		}
+		renderer.DrawU8String(0, y, m_textRow, y % 2 == 0 ? vt::color::ForegroundBrightWhite : vt::color::ForegroundBrightCyan);
+	}
+}
+
+void Benchmark::RenderGradient(nu::console::ConsoleRenderer& renderer)
+{
+	for (uint16_t y = 0; y < m_height; ++y)
+	{
+		for (uint16_t x = 0; x < m_width; ++x)
+		{
+			const auto& color = m_gradientColors[(x * 2 + y * 5 + m_currentFrame * 3) % m_gradientColors.size()];
+			renderer.DrawChar(x, y, ' ', vt::color::ForegroundWhite, color);
+		}
+	}
+}
+
+void Benchmark::RenderBoxDrawing(nu::console::ConsoleRenderer& renderer)
+{
+	auto& arena = GetEngine()->GetFrameArena();
+
+	// Draws a box with a title in its top edge
+	auto drawBox = [this, &renderer](uint16_t left, uint16_t top, uint16_t width, uint16_t height, std::string_view title)
+	{
+		if (width < 2 || height < 2)
+		{
+			return;
+		}
+
+		auto drawEdge = [this, &renderer, left, width](uint16_t y, std::u8string_view start, std::u8string_view end)
+		{
+			m_textRow = start;
+			for (uint16_t x = 2; x < width; ++x)
+			{
+				m_textRow += u8"─";
+			}
+			m_textRow += end;
+			renderer.DrawU8String(left, y, m_textRow, vt::color::ForegroundBrightBlue);
+		};
+
+		drawEdge(top, u8"┌", u8"┐");
+		for (uint16_t y = top + 1; y < top + height - 1; ++y)
+		{
+			renderer.DrawU8Char(left, y, u8"│", vt::color::ForegroundBrightBlue);
+			renderer.DrawU8Char(left + width - 1, y, u8"│", vt::color::ForegroundBrightBlue);
+		}
+		drawEdge(top + height - 1, u8"└", u8"┘");
+		renderer.DrawString(left + 2, top, title, vt::color::ForegroundBrightWhite);
+	};
+
+	// A list on the left with a moving selection, a table at the top right and progress bars at the bottom right
+	const uint16_t listWidth = std::max<uint16_t>(m_width / 3, 2);
+	const uint16_t rightWidth = m_width > listWidth ? m_width - listWidth : 0;
+	const uint16_t tableHeight = std::max<uint16_t>(m_height / 2, 2);
+	const uint16_t barsHeight = m_height > tableHeight ? m_height - tableHeight : 0;
+	drawBox(0, 0, listWidth, m_height, " Inventory "sv);
+	drawBox(listWidth, 0, rightWidth, tableHeight, " Statistics "sv);
+	drawBox(listWidth, tableHeight, rightWidth, barsHeight, " Progress "sv);
+
+	const int listRows = std::max(m_height - 2, 1);
+	const auto selectedRow = static_cast<int>(m_currentFrame / 4 % listRows);
+	for (int row = 0; row < listRows; ++row)
+	{
+		const bool isSelected = row == selectedRow;
+		renderer.DrawString(
+			1,
+			row + 1,
+			arena.Format(" Item {:>3}  x{:>2}"sv, row + 1, (row * 7 + 3) % 20),
+			isSelected ? vt::color::ForegroundBlack : vt::color::ForegroundWhite,
+			isSelected ? vt::color::BackgroundBrightCyan : vt::color::BackgroundBlack);
+	}
+
+	for (int row = 0; row < tableHeight - 2; ++row)
+	{
+		const auto value = static_cast<int64_t>((m_currentFrame * (row + 1) * 37) % 100000);
+		renderer.DrawString(listWidth + 2, row + 1, arena.Format("Counter {:<3}"sv, row + 1), vt::color::ForegroundWhite);
+		renderer.DrawU8Char(listWidth + 14, row + 1, u8"│", vt::color::ForegroundBrightBlue);
+		renderer.DrawString(listWidth + 16, row + 1, arena.Format("{:>8}"sv, value), vt::color::ForegroundBrightWhite);
+		renderer.DrawU8Char(listWidth + 25, row + 1, u8"│", vt::color::ForegroundBrightBlue);
+		renderer.DrawString(listWidth + 27, row + 1, arena.Format("{:>+6}"sv, value % 201 - 100), vt::color::ForegroundBrightGreen);
+	}
+
+	const int barWidth = std::max(rightWidth - 4, 0);
+	for (int row = 0; row < barsHeight - 2; ++row)
+	{
+		const auto filled = static_cast<int>(m_currentFrame * (row + 1) / 3 % (barWidth + 1));
+		m_textRow.clear();
+		for (int x = 0; x < barWidth; ++x)
+		{
+			m_textRow += x < filled ? u8"█" : u8"░";
+		}
+		renderer.DrawU8String(listWidth + 2, tableHeight + row + 1, m_textRow, vt::color::ForegroundBrightGreen);
+	}
+}
+
+void Benchmark::RenderSprites(nu::console::ConsoleRenderer& renderer)
+{
+	for (const auto& sprite : m_sprites)
+	{
+		const auto x = static_cast<uint16_t>(sprite.x);
+		const auto y = static_cast<uint16_t>(sprite.y);
+		for (uint16_t row = 0; row < spriteHeight; ++row)
+		{
+			renderer.DrawString(x, y + row, spriteShape[row], colors[sprite.color]);
+		}
+	}
 }
 
-void Benchmark::OnWindowResize(uint16_t /*width*/, uint16_t /*height*/)
+void Benchmark::OnWindowResize(uint16_t width, uint16_t height)
 {
+	// The resize storm resizes the renderer itself
+	if (m_phase >= 0 && m_phase < m_phaseConfigs.size() && m_phaseConfigs[m_phase].workload == Workload::ResizeStorm)
+	{
+		return;
+	}
+
+	// Keep a requested size even when the window changes
+	if (m_options.width > 0 && m_options.height > 0 && (width != m_options.width || height != m_options.height))
+	{
+		GetEngine()->SetDesiredRendererSize(m_options.width, m_options.height);
+		return;
+	}
+
+	// Back at the size the scenes were created for, such as after a resize storm
+	if (width == m_width && height == m_height)
+	{
+		return;
+	}
+
 	if (m_phase < m_phaseConfigs.size())
 	{
 		Restart();
@@ -365,3 +919,167 @@ bool Benchmark::OnKeyDown(nu::console::Key key)
 	}
 	return false;
 }
+
+void Benchmark::FinishUnattendedRun()
+{
+	m_summary = std::format("Benchmark ran {} phases of {} frames at {}x{} characters, seed {}\n", m_phaseConfigs.size(), m_options.framesPerPhase, m_width, m_height, m_options.seed);
+	for (size_t i = 0; i < m_phaseResults.size(); ++i)
+	{
+		const auto& frameTimeStatistics = m_phaseResults[i].GetStatistics(nu::engine::TimingBucket::Frame);
+		const auto& presentTimeStatistics = m_phaseResults[i].GetStatistics(nu::engine::TimingBucket::Present);
+		std::format_to(
+			std::back_inserter(m_summary),
+			"  {:<20} frame p50 {:>7.3f}ms p99 {:>7.3f}ms   present p50 {:>7.3f}ms p99 {:>7.3f}ms\n",
+			m_phaseConfigs[i].name,
+			ToMs(frameTimeStatistics.p50),
+			ToMs(frameTimeStatistics.p99),
+			ToMs(presentTimeStatistics.p50),
+			ToMs(presentTimeStatistics.p99));
+	}
+
+	if (!m_options.resultsPath.empty())
+	{
+		if (WriteResults(m_options.resultsPath))
+		{
+			std::format_to(std::back_inserter(m_summary), "Wrote results to {}\n", m_options.resultsPath.string());
+		}
+		else
+		{
+			std::format_to(std::back_inserter(m_summary), "Failed to write results to {}\n", m_options.resultsPath.string());
+			m_exitCode = exitCodeError;
+		}
+	}
+
+	if (!m_options.baselinePath.empty())
+	{
+		bool hasRegressed = false;
+		if (!CompareWithBaseline(m_options.baselinePath, hasRegressed))
+		{
+			std::format_to(std::back_inserter(m_summary), "Failed to read baseline {}\n", m_options.baselinePath.string());
+			m_exitCode = exitCodeError;
+		}
+		else if (hasRegressed && m_exitCode == exitCodeSuccess)
+		{
+			m_exitCode = exitCodeRegression;
+		}
+	}
+
+	GetEngine()->StopGame();
+}
+
+bool Benchmark::WriteResults(const std::filesystem::path& path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+
+	// Noise is updated through the job system, so tick_ms includes dispatching to and joining its workers; results written
+	// before that don't have tick_includes_job_dispatch, and their tick times aren't comparable
+	file << std::format(
+		"{{\n  \"width\": {},\n  \"height\": {},\n  \"seed\": {},\n  \"frames_per_phase\": {},\n  \"job_workers\": {},\n"
+		"  \"tick_includes_job_dispatch\": true,\n  \"phases\": [\n",
+		m_width,
+		m_height,
+		m_options.seed,
+		m_options.framesPerPhase,
+		m_jobWorkerCount);
+	for (size_t i = 0; i < m_phaseResults.size(); ++i)
+	{
+		const auto& phaseResult = m_phaseResults[i];
+		file << std::format("    {{\n      \"name\": \"{}\",\n      \"frames\": {}", m_phaseConfigs[i].name, phaseResult.frames);
+
+		const auto averageTimings = GetTimings(phaseResult.averageFrameTimings);
+		for (size_t bucket = 0; bucket < timingBucketCount; ++bucket)
+		{
+			const auto& statistics = phaseResult.statistics[bucket];
+			file << std::format(
+				",\n      \"{}\": {{ \"mean\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, \"max\": {:.4f}, \"jitter\": {:.4f} }}",
+				timingNames[bucket],
+				ToMs(averageTimings[bucket]),
+				ToMs(statistics.p50),
+				ToMs(statistics.p95),
+				ToMs(statistics.p99),
+				ToMs(statistics.max),
+				ToMs(statistics.jitter));
+		}
+		file << (i + 1 < m_phaseResults.size() ? "\n    },\n" : "\n    }\n");
+	}
+	file << "  ]\n}\n";
+
+	return file.good();
+}
+
+bool Benchmark::CompareWithBaseline(const std::filesystem::path& path, bool& hasRegressed)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	const std::string json = stream.str();
+
+	size_t offset = 0;
+	const auto baselineWidth = FindNumber(json, "width", offset);
+	const auto baselineHeight = FindNumber(json, "height", offset);
+	if (!baselineWidth || !baselineHeight)
+	{
+		return false;
+	}
+
+	std::format_to(std::back_inserter(m_summary), "Comparing frame times against {}, allowing {}% slower\n", path.string(), m_options.regressionThreshold);
+	if (*baselineWidth != m_width || *baselineHeight != m_height)
+	{
+		std::format_to(std::back_inserter(m_summary), "  Baseline was recorded at {}x{} characters, so timings may not be comparable\n", *baselineWidth, *baselineHeight);
+	}
+	if (json.find("\"tick_includes_job_dispatch\": true") == std::string::npos)
+	{
+		m_summary += "  Baseline tick times exclude job system dispatch, which tick times now include\n";
+	}
+
+	hasRegressed = false;
+	const double limit = 1.0 + m_options.regressionThreshold / 100.0;
+	for (size_t i = 0; i < m_phaseResults.size(); ++i)
+	{
+		const auto& name = m_phaseConfigs[i].name;
+
+		// Only search within the phase's own entry
+		const auto phaseStart = json.find(std::format("\"name\": \"{}\"", name));
+		const auto phaseEnd = phaseStart == std::string::npos ? std::string::npos : json.find("\"name\":", phaseStart + 1);
+		const std::string_view phaseJson = phaseStart == std::string::npos ? std::string_view() : std::string_view(json).substr(phaseStart, phaseEnd - phaseStart);
+
+		size_t phaseOffset = phaseJson.find("\"frame_ms\":");
+		const auto baselineP50 = phaseOffset == std::string_view::npos ? std::nullopt : FindNumber(phaseJson, "p50", phaseOffset);
+		const auto baselineP95 = baselineP50 ? FindNumber(phaseJson, "p95", phaseOffset) : std::nullopt;
+		if (!baselineP50 || !baselineP95)
+		{
+			std::format_to(std::back_inserter(m_summary), "  {:<20} not in baseline\n", name);
+			continue;
+		}
+
+		// Both the typical frame and the slow tail have to stay within the threshold
+		const auto& statistics = m_phaseResults[i].GetStatistics(nu::engine::TimingBucket::Frame);
+		const double p50 = ToMs(statistics.p50);
+		const double p95 = ToMs(statistics.p95);
+		auto getChange = [](double value, double baseline) { return baseline > 0.0 ? (value / baseline - 1.0) * 100.0 : 0.0; };
+		const bool hasPhaseRegressed = p50 > *baselineP50 * limit || p95 > *baselineP95 * limit;
+		hasRegressed |= hasPhaseRegressed;
+		std::format_to(
+			std::back_inserter(m_summary),
+			"  {:<20} p50 {:>7.3f}ms -> {:>7.3f}ms ({:>+6.1f}%)   p95 {:>7.3f}ms -> {:>7.3f}ms ({:>+6.1f}%){}\n",
+			name,
+			*baselineP50,
+			p50,
+			getChange(p50, *baselineP50),
+			*baselineP95,
+			p95,
+			getChange(p95, *baselineP95),
+			hasPhaseRegressed ? "   REGRESSED" : "");
+	}
+
+	return true;
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <filesystem>
+#include <optional>
 #include <random>
+#include <span>
+#include <string>
+#include <vector>
 
 #include "NuEngine/Engine.h"
 #include "NuEngine/Game.h"
@@ -8,7 +13,50 @@
 class Benchmark : public nu::engine::Game
 {
 public:
-	Benchmark();
+	// Exit codes of an unattended run
+	static constexpr int exitCodeSuccess = 0;
+	static constexpr int exitCodeRegression = 1;
+	static constexpr int exitCodeError = 2;
+
+	// Settings for a benchmark run, usually parsed from the command line
+	struct Options
+	{
+		// Renderer size in characters; zero uses the window size. May be larger than the window, to benchmark huge
+		// canvases; what falls outside the window is still built and written, so it costs the same.
+		uint16_t width = 0;
+		uint16_t height = 0;
+
+		uint32_t seed = 42;
+		uint32_t framesPerPhase = 500;
+
+		// One-based numbers of the phases to run, in order; empty runs every phase
+		std::vector<size_t> phases;
+
+		// Skips the countdown and the results screen, and stops the engine once every phase has run
+		bool isUnattended = false;
+
+		// JSON file the results are written to when unattended; empty writes no file
+		std::filesystem::path resultsPath;
+
+		// JSON results of an earlier run to compare against when unattended; empty compares nothing
+		std::filesystem::path baselinePath;
+
+		// How many percent slower than the baseline a phase's frame time may be before it counts as a regression
+		double regressionThreshold = 10.0;
+	};
+
+	// Parses command line arguments, excluding the program name. Returns no options if the arguments are invalid,
+	// with the reason in error, or if help was requested, with an empty error.
+	static std::optional<Options> ParseCommandLine(std::span<char* const> args, std::string& error);
+
+	// Describes the command line arguments
+	static std::string GetUsage();
+
+	Benchmark() : Benchmark(Options{})
+	{
+	}
+
+	explicit Benchmark(const Options& options);
 
 	void BeginPlay() override;
 	void EndPlay() override;
@@ -17,6 +65,18 @@ public:
 	void OnWindowResize(uint16_t width, uint16_t height) override;
 	bool OnKeyDown(nu::console::Key key) override;
 
+	// Exit code of an unattended run; a success until the run has finished
+	int GetExitCode() const noexcept
+	{
+		return m_exitCode;
+	}
+
+	// Text describing how an unattended run went, to print once the engine has stopped
+	const std::string& GetSummary() const noexcept
+	{
+		return m_summary;
+	}
+
 	// Delete copy/move construction and assignment
 private:
 	Benchmark(Benchmark&) = delete;
@@ -24,11 +84,39 @@ private:
 	Benchmark& operator=(Benchmark&) = delete;
 	Benchmark& operator=(Benchmark&&) = delete;
 
+	// Creates the parts of the scenes that don't depend on the renderer size
+	void InitializeScenes();
+
 	void Restart();
 
+	// Draws each kind of scene
+	void RenderNoise(nu::console::ConsoleRenderer& renderer);
+	void RenderScroll(nu::console::ConsoleRenderer& renderer);
+	void RenderSparseHud(nu::console::ConsoleRenderer& renderer);
+	void RenderUnicode(nu::console::ConsoleRenderer& renderer);
+	void RenderGradient(nu::console::ConsoleRenderer& renderer);
+	void RenderBoxDrawing(nu::console::ConsoleRenderer& renderer);
+	void RenderSprites(nu::console::ConsoleRenderer& renderer);
+
+	// Writes the results, compares them against the baseline and stops the engine
+	void FinishUnattendedRun();
+
+	// Writes the results as JSON; returns false if the file can't be written
+	bool WriteResults(const std::filesystem::path& path) const;
+
+	// Compares the results against a baseline written by WriteResults, appending a line per phase to the summary.
+	// Returns false if the baseline can't be read.
+	bool CompareWithBaseline(const std::filesystem::path& path, bool& hasRegressed);
+
 private:
-	uint32_t m_rngSeed = 42;
-	std::mt19937 m_rng{ std::random_device{}() };
+	Options m_options;
+	std::mt19937 m_rng;
+
+	int m_exitCode = exitCodeSuccess;
+	std::string m_summary;
+
+	// Workers of the engine's job system, which the noise update is spread across; written with the results
+	uint32_t m_jobWorkerCount = 0;
 
 	uint64_t m_currentFrame = 0;
 	int8_t m_phase = -1;
@@ -41,16 +129,89 @@ private:
 	uint16_t m_width = 0;
 	uint16_t m_height = 0;
 
+	// Small moving object of the sprites scene
+	struct Sprite
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+
+		// Cells moved each frame
+		float velocityX = 0.0f;
+		float velocityY = 0.0f;
+
+		uint8_t color = 0;
+	};
+
+	std::vector<Sprite> m_sprites;
+	std::vector<Sprite> m_spritesOriginal;
+
+	// Hue wheel of 24-bit background colors for the gradient scene
+	std::vector<std::string> m_gradientColors;
+
+	// Code points of the text in the Unicode scene
+	std::vector<std::u8string> m_unicodeCodePoints;
+
+	// Reused to build rows of UTF-8 text
+	std::u8string m_textRow;
+
+	// Kinds of scene a phase renders
+	enum class Workload : uint8_t
+	{
+		// Random symbols, a share of which change each frame
+		Noise,
+
+		// A log scrolling up a line each frame, so every row changes
+		Scroll,
+
+		// A static background redrawn every frame under a small HUD that changes
+		SparseHud,
+
+		// Rows of multi-byte UTF-8 text and emoji scrolling sideways
+		Unicode,
+
+		// Full-screen 24-bit color gradient shifting each frame
+		Gradient,
+
+		// Panels, a table and progress bars drawn with box-drawing characters
+		BoxDrawing,
+
+		// Many small sprites moving over an empty background
+		Sprites,
+
+		// Noise while the renderer is resized every few frames
+		ResizeStorm
+	};
+
 	struct PhaseConfig
 	{
+		// Identifies the phase in results files, so baselines still match when other phases are added or skipped
+		std::string name;
+
+		// Shown before the run and with the results
+		std::string description;
+
+		Workload workload = Workload::Noise;
+
+		// Noise and resize storm only
 		uint8_t changePercent = 10;
 		bool renderColor = false;
 	};
 
+	// Every phase, in the order they run by default
+	static std::vector<PhaseConfig> CreatePhaseConfigs();
+
 	struct PhaseResult
 	{
 		uint64_t frames = 0;
 		nu::engine::FrameTimings averageFrameTimings;
+
+		// Averages hide stutter, so the distribution of each timing is kept too
+		std::array<nu::engine::TimingStatistics, static_cast<size_t>(nu::engine::TimingBucket::Count)> statistics;
+
+		const nu::engine::TimingStatistics& GetStatistics(nu::engine::TimingBucket bucket) const noexcept
+		{
+			return statistics[static_cast<size_t>(bucket)];
+		}
 	};
 
 	std::vector<std::vector<nu::engine::FrameTimings>> m_phaseFrameTimings;
@@ -1,11 +1,31 @@
-﻿#include "NuEngine/Engine.h"
+﻿#include <cstdio>
+#include <span>
+#include <string>
+
+#include "NuEngine/Engine.h"
 
 #include "Benchmark.h"
 #include "Snowflakes.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+	std::string error;
+	const auto options = Benchmark::ParseCommandLine(std::span(argv + 1, argc > 0 ? argc - 1 : 0), error);
+	if (!options)
+	{
+		if (!error.empty())
+		{
+			std::fprintf(stderr, "%s\n", error.c_str());
+		}
+		std::fputs(Benchmark::GetUsage().c_str(), error.empty() ? stdout : stderr);
+		return error.empty() ? Benchmark::exitCodeSuccess : Benchmark::exitCodeError;
+	}
+
 	nu::engine::Engine engine;
-	Benchmark game;
+	Benchmark game(*options);
 	engine.StartGame(game);
+
+	// The console is restored once the engine stops, so the summary stays visible
+	std::fputs(game.GetSummary().c_str(), stdout);
+	return game.GetExitCode();
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "NuEngine/ConsoleRenderer.h"
 #include "NuEngine/Engine.h"
+#include "NuEngine/Profiler.h"
 #include "NuEngine/VirtualTerminalSequences.h"
 
 using namespace nu::console;
@@ -16,17 +17,49 @@ using namespace std::literals;
 void Snowflakes::BeginPlay()
 {
 	GetEngine()->SetTargetFramesPerSecond(240);
+	GetEngine()->SetPipelinedTickEnabled(true);
 	auto [width, height] = GetEngine()->GetRendererSize();
 	m_position = width / 2;
 	m_columns.resize(width);
+
+	// A command rather than a bool variable, so a bare "autoplay" still toggles it as before the commander had variables
+	GetEngine()->GetCommands().RegisterCommand(
+		u8"autoplay",
+		u8"Moves the spawner and spawns snowflakes automatically: autoplay [on|off]; toggles without an argument",
+		[this](std::span<const std::u8string_view> arguments)
+		{
+			bool enableAutoplay = !m_autoplayEnabled;
+			if (!arguments.empty() && !nu::engine::CommandRegistry::TryParseBool(arguments.front(), enableAutoplay))
+			{
+				return u8"Invalid value for autoplay: " + std::u8string(arguments.front());
+			}
+
+			m_autoplayEnabled = enableAutoplay;
+			return u8"autoplay = "s + (m_autoplayEnabled ? u8"on" : u8"off");
+		});
+}
+
+void Snowflakes::EndPlay()
+{
+	GetEngine()->GetCommands().Unregister(u8"autoplay");
 }
 
 void Snowflakes::Tick(std::chrono::duration<double> deltaTime)
 {
+	NU_PROFILE_SCOPE("Snowflakes::Tick");
+
 	if (m_autoplayEnabled)
 	{
 		TickAutoplay(deltaTime);
 	}
+	else
+	{
+		// Move the spawner while a direction is held
+		const auto* engine = GetEngine();
+		const bool isMovingLeft = engine->IsKeyDown(Key::A) || engine->IsKeyDown(Key::Left);
+		const bool isMovingRight = engine->IsKeyDown(Key::D) || engine->IsKeyDown(Key::Right);
+		m_velocity = (isMovingRight ? 1 : 0) - (isMovingLeft ? 1 : 0);
+	}
 
 	m_position += m_velocity;
 	m_position = std::clamp(m_position, 0, static_cast<int>(m_columns.size() - 1));
@@ -61,32 +94,48 @@ void Snowflakes::Tick(std::chrono::duration<double> deltaTime)
 			}
 		}
 	}
+
+	PublishRenderSnapshot();
 }
 
 void Snowflakes::Render(nu::console::ConsoleRenderer& renderer)
 {
+	NU_PROFILE_SCOPE("Snowflakes::Render");
+
+	// Only draw from the snapshot; the simulation may be ticking on another thread
+	const auto& snapshot = m_renderSnapshots.Read();
+
 	// Draw spawner
-	renderer.DrawU8Char(m_position, 0, u8"▼", vt::color::ForegroundBrightWhite);
+	renderer.DrawU8Char(snapshot.position, 0, u8"▼", vt::color::ForegroundBrightWhite);
 
 	// Draw snowflakes
+	for (const auto& snowflake : snapshot.snowflakes)
+	{
+		renderer.DrawU8Char(snowflake.x, snowflake.y, u8"❄", vt::color::ForegroundBrightCyan);
+		for (int j = 1; snowflake.y - j >= 1 && j < 5; ++j)
+		{
+			renderer.DrawU8Char(snowflake.x, snowflake.y - j, u8"•", vt::color::ForegroundCyan);
+		}
+	}
+}
+
+void Snowflakes::PublishRenderSnapshot()
+{
+	// Reuse the snapshot's allocation; it holds an older frame's state
+	auto& snapshot = m_renderSnapshots.GetWriteBuffer();
+	snapshot.position = m_position;
+	snapshot.snowflakes.clear();
 	for (uint16_t x = 0; x < m_columns.size(); ++x)
 	{
 		for (const auto& snowflake : m_columns[x])
 		{
+			if (snowflake.y != -1)
 			{
-				if (snowflake.y == -1)
-				{
-					continue;
-				}
-
-				renderer.DrawU8Char(x, snowflake.y, u8"❄", vt::color::ForegroundBrightCyan);
-				for (int j = 1; snowflake.y - j >= 1 && j < 5; ++j)
-				{
-					renderer.DrawU8Char(x, snowflake.y - j, u8"•", vt::color::ForegroundCyan);
-				}
+				snapshot.snowflakes.push_back({ .x = x, .y = snowflake.y });
 			}
 		}
 	}
+	m_renderSnapshots.Publish();
 }
 
 void Snowflakes::OnWindowResize(uint16_t width, uint16_t height)
@@ -103,22 +152,6 @@ bool Snowflakes::OnKeyDown(Key key)
 			// Spawn snowflake
 			m_columns[m_position].emplace_back(1, 0ms);
 			return true;
-		case Key::A:
-		case Key::Left:
-			// Move spawner left
-			if (m_velocity > -1)
-			{
-				--m_velocity;
-			}
-			return true;
-		case Key::D:
-		case Key::Right:
-			// Move spawner right
-			if (m_velocity < 1)
-			{
-				++m_velocity;
-			}
-			return true;
 		case Key::P:
 			// Toggle autoplay
 			m_autoplayEnabled = !m_autoplayEnabled;
@@ -128,42 +161,6 @@ bool Snowflakes::OnKeyDown(Key key)
 	}
 }
 
-bool Snowflakes::OnKeyUp(Key key)
-{
-	switch (key)
-	{
-		case Key::A:
-		case Key::Left:
-			// Stop moving the spawner left
-			if (m_velocity < 1)
-			{
-				++m_velocity;
-			}
-			return true;
-		case Key::D:
-		case Key::Right:
-			// Stop moving the spawner right
-			if (m_velocity > -1)
-			{
-				--m_velocity;
-			}
-			return true;
-		default:
-			return false;
-	}
-}
-
-bool Snowflakes::OnLineInput(const std::u8string& line)
-{
-	if (line == u8"autoplay")
-	{
-		m_autoplayEnabled = !m_autoplayEnabled;
-		return true;
-	}
-
-	return false;
-}
-
 void Snowflakes::TickAutoplay(std::chrono::duration<double> deltaTime)
 {
 	static std::chrono::milliseconds timeSinceLastMovement = 0ms;
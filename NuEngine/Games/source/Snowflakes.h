@@ -1,6 +1,7 @@
 #pragma once
 
 #include "NuEngine/Game.h"
+#include "NuEngine/TripleBuffer.h"
 
 class Snowflakes : public nu::engine::Game
 {
@@ -13,15 +14,12 @@ public:
 	// Called when a key is pressed in Keys input mode
 	bool OnKeyDown(nu::console::Key key) override;
 
-	// Called when a key is released  in Keys input mode
-	bool OnKeyUp(nu::console::Key key) override;
-
-	// Called when a line of text is completed in Lines input mode
-	bool OnLineInput(const std::u8string& line) override;
-
 	// Called when the game is starting
 	void BeginPlay() override;
 
+	// Called when the game is ending
+	void EndPlay() override;
+
 	// Called each frame to update the game simulation
 	void Tick(std::chrono::duration<double> deltaTime) override;
 
@@ -32,6 +30,9 @@ private:
 	// Drives the simulation when autoplay is enabled
 	void TickAutoplay(std::chrono::duration<double> deltaTime);
 
+	// Publishes the simulation state for Render
+	void PublishRenderSnapshot();
+
 	// Delete copy/move construction and assignment
 private:
 	Snowflakes(Snowflakes&) = delete;
@@ -46,8 +47,22 @@ private:
 		std::chrono::milliseconds accruedTime = std::chrono::milliseconds::zero();
 	};
 
+	// Everything Render draws, published by Tick so Render can run concurrently with the next Tick
+	struct RenderSnapshot
+	{
+		struct Sprite
+		{
+			uint16_t x = 0;
+			int y = 0;
+		};
+
+		int position = 0;
+		std::vector<Sprite> snowflakes;
+	};
+
 	int m_position = 0;
 	int m_velocity = 0;
 	bool m_autoplayEnabled = false;
 	std::vector<std::vector<Snowflake>> m_columns;
+	nu::engine::TripleBuffer<RenderSnapshot> m_renderSnapshots;
 };
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+class Harness;
+
+// Runs the benchmarks of the clock sources and the timing built on them: Stopwatch and profile scopes
+void RunClockBenchmarks(Harness& harness);
+
+// Runs the benchmarks of ConsoleRenderer: drawing, clearing, decoding UTF-8 and presenting
+void RunRendererBenchmarks(Harness& harness);
+
+// Runs the benchmarks of the virtual terminal sequence builders
+void RunVirtualTerminalBenchmarks(Harness& harness);
+
+// Runs the benchmarks of line input
+void RunInputBenchmarks(Harness& harness);
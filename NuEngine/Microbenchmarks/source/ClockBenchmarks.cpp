@@ -0,0 +1,38 @@
+#include "Benchmarks.h"
+
+#include "NuEngine/Clock.h"
+#include "NuEngine/Profiler.h"
+#include "NuEngine/Stopwatch.h"
+
+#include "Harness.h"
+
+using namespace nu::engine;
+
+void RunClockBenchmarks(Harness& harness)
+{
+	harness.Run("Clock::Now/steady", []() { DoNotOptimize(clock::Now(ClockSource::Steady)); });
+
+	if (clock::IsTscAvailable())
+	{
+		harness.Run("Clock::Now/TSC", []() { DoNotOptimize(clock::Now(ClockSource::Tsc)); });
+	}
+
+	// Restart and Stop are the timestamps the engine takes around each part of a frame
+	Stopwatch stopwatch;
+	harness.Run(
+		"Stopwatch/restart and stop",
+		[&stopwatch]()
+		{
+			stopwatch.Restart();
+			stopwatch.Stop();
+			DoNotOptimize(stopwatch.ElapsedTicks());
+		});
+
+	// Profiling stays enabled across batches, so events are dropped once the ring is full; a dropped event still costs
+	// both timestamps
+	harness.Run("ProfileScope/disabled", []() { NU_PROFILE_SCOPE("Benchmark"); });
+
+	profiler::SetEnabled(true);
+	harness.Run("ProfileScope/enabled", []() { NU_PROFILE_SCOPE("Benchmark"); });
+	profiler::SetEnabled(false);
+}
@@ -0,0 +1,127 @@
+#include "Harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <numeric>
+
+namespace details
+{
+	const void* volatile g_doNotOptimizeSink = nullptr;
+} // namespace details
+
+namespace
+{
+	// Returns the value at a percentile of sorted values, using the nearest rank
+	double GetPercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		const auto rank = static_cast<size_t>(std::ceil(percentile * sortedValues.size()));
+		return sortedValues[std::clamp<size_t>(rank, 1, sortedValues.size()) - 1];
+	}
+
+	double GetMedian(const std::vector<double>& sortedValues)
+	{
+		const size_t middle = sortedValues.size() / 2;
+		return sortedValues.size() % 2 == 0 ? (sortedValues[middle - 1] + sortedValues[middle]) / 2.0 : sortedValues[middle];
+	}
+} // namespace
+
+void Harness::RunBatches(std::string_view name, const BatchFunction& runBatch)
+{
+	const double sampleTime = m_settings.sampleTime.count();
+
+	// Grow the batch until it takes the sample time; the growth is capped, as the first batches include cold caches
+	uint64_t iterations = 1;
+	double warmupTime = 0.0;
+	while (true)
+	{
+		const double batchTime = runBatch(iterations).count();
+		warmupTime += batchTime;
+		if (batchTime >= sampleTime)
+		{
+			break;
+		}
+
+		const double growth = batchTime > 0.0 ? sampleTime / batchTime * 1.2 : 100.0;
+		iterations = static_cast<uint64_t>(std::ceil(static_cast<double>(iterations) * std::clamp(growth, 2.0, 100.0)));
+	}
+
+	while (warmupTime < m_settings.warmupTime.count())
+	{
+		warmupTime += runBatch(iterations).count();
+	}
+
+	std::vector<double> samples(std::max<uint32_t>(m_settings.samples, 1));
+	for (auto& sample : samples)
+	{
+		sample = runBatch(iterations).count() * 1'000'000'000.0 / static_cast<double>(iterations);
+	}
+	std::ranges::sort(samples);
+
+	Result result{ .name = std::string(name), .iterationsPerSample = iterations, .samples = static_cast<uint32_t>(samples.size()) };
+	result.min = samples.front();
+	result.median = GetMedian(samples);
+	result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+	result.p95 = GetPercentile(samples, 0.95);
+
+	std::vector<double> deviations(samples.size());
+	std::ranges::transform(samples, deviations.begin(), [&result](double sample) { return std::abs(sample - result.median); });
+	std::ranges::sort(deviations);
+	result.deviationPercent = result.median > 0.0 ? GetMedian(deviations) / result.median * 100.0 : 0.0;
+
+	m_results.push_back(std::move(result));
+}
+
+void Harness::PrintResults(std::ostream& stream) const
+{
+	size_t nameWidth = std::string_view("Benchmark").size();
+	for (const auto& result : m_results)
+	{
+		nameWidth = std::max(nameWidth, result.name.size());
+	}
+
+	stream << std::format("{:<{}}  {:>12}  {:>12}  {:>12}  {:>7}  {:>12}\n", "Benchmark", nameWidth, "median ns", "min ns", "p95 ns", "+/-", "iterations");
+	for (const auto& result : m_results)
+	{
+		stream << std::format(
+			"{:<{}}  {:>12.2f}  {:>12.2f}  {:>12.2f}  {:>6.1f}%  {:>12}\n",
+			result.name,
+			nameWidth,
+			result.median,
+			result.min,
+			result.p95,
+			result.deviationPercent,
+			result.iterationsPerSample);
+	}
+}
+
+bool Harness::WriteResults(const std::filesystem::path& path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+
+	file << "{\n";
+	for (size_t i = 0; i < m_results.size(); ++i)
+	{
+		const auto& result = m_results[i];
+		file << std::format(
+			"  \"{}\": {{ \"median_ns\": {:.3f}, \"min_ns\": {:.3f}, \"mean_ns\": {:.3f}, \"p95_ns\": {:.3f}, \"deviation_percent\": {:.2f}, "
+			"\"iterations\": {}, \"samples\": {} }}{}\n",
+			result.name,
+			result.median,
+			result.min,
+			result.mean,
+			result.p95,
+			result.deviationPercent,
+			result.iterationsPerSample,
+			result.samples,
+			i + 1 < m_results.size() ? "," : "");
+	}
+	file << "}\n";
+
+	return file.good();
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NuEngine/Stopwatch.h"
+
+namespace details
+{
+	extern const void* volatile g_doNotOptimizeSink;
+} // namespace details
+
+// Keeps the compiler from optimizing away the computation of a value
+template<typename T>
+void DoNotOptimize(const T& value)
+{
+	details::g_doNotOptimizeSink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+// Times small pieces of code. Each benchmark is warmed up, then run in batches of a calibrated number of iterations,
+// so every batch takes about the sample time regardless of how fast one iteration is.
+class Harness
+{
+public:
+	struct Settings
+	{
+		// Benchmarks run for at least this long before samples are taken
+		std::chrono::duration<double> warmupTime = std::chrono::milliseconds(100);
+
+		// Duration each sampled batch of iterations aims for
+		std::chrono::duration<double> sampleTime = std::chrono::milliseconds(10);
+
+		// Number of batches sampled per benchmark
+		uint32_t samples = 30;
+
+		// Only benchmarks with names containing this text run; empty runs every benchmark
+		std::string filter;
+	};
+
+	// Time per iteration over the sampled batches, in nanoseconds
+	struct Result
+	{
+		std::string name;
+		uint64_t iterationsPerSample = 0;
+		uint32_t samples = 0;
+		double min = 0.0;
+		double median = 0.0;
+		double mean = 0.0;
+		double p95 = 0.0;
+
+		// Median absolute deviation, as a percentage of the median; high values mean the result is noisy
+		double deviationPercent = 0.0;
+	};
+
+	explicit Harness(Settings settings) : m_settings(std::move(settings))
+	{
+	}
+
+	// Returns true if the filter selects the benchmark
+	bool ShouldRun(std::string_view name) const noexcept
+	{
+		return m_settings.filter.empty() || name.find(m_settings.filter) != std::string_view::npos;
+	}
+
+	// Runs a benchmark now, calling the function once per iteration. Anything the function computes must be passed
+	// to DoNotOptimize, or the compiler may remove it.
+	template<typename Function>
+	void Run(std::string_view name, Function&& function)
+	{
+		if (!ShouldRun(name))
+		{
+			return;
+		}
+
+		RunBatches(
+			name,
+			[&function](uint64_t iterations)
+			{
+				nu::engine::Stopwatch stopwatch;
+				stopwatch.Restart();
+				for (uint64_t i = 0; i < iterations; ++i)
+				{
+					function();
+				}
+				return stopwatch.ElapsedSeconds();
+			});
+	}
+
+	const std::vector<Result>& GetResults() const noexcept
+	{
+		return m_results;
+	}
+
+	// Writes the results as a table
+	void PrintResults(std::ostream& stream) const;
+
+	// Writes the results as JSON, keyed by benchmark name; returns false if the file can't be written
+	bool WriteResults(const std::filesystem::path& path) const;
+
+	// Delete copy/move construction and assignment
+private:
+	Harness(Harness&) = delete;
+	Harness(Harness&&) = delete;
+	Harness& operator=(Harness&) = delete;
+	Harness& operator=(Harness&&) = delete;
+
+private:
+	using BatchFunction = std::function<std::chrono::duration<double>(uint64_t iterations)>;
+
+	// Calibrates, warms up and samples a benchmark, then adds its result
+	void RunBatches(std::string_view name, const BatchFunction& runBatch);
+
+private:
+	Settings m_settings;
+	std::vector<Result> m_results;
+};
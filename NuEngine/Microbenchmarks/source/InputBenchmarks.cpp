@@ -0,0 +1,37 @@
+#include "Benchmarks.h"
+
+#include "NuEngine/LineEditor.h"
+
+#include "Harness.h"
+
+using namespace nu::console;
+
+// ConsoleEventStream::GetCurrentLine returns its LineEditor's text, so these run the editor directly rather than
+// through a stream, which would need real console input to build a line
+void RunInputBenchmarks(Harness& harness)
+{
+	LineEditor lineEditor;
+	lineEditor.Insert(u8"profile_export traces/frame_budget.json");
+
+	harness.Run("GetCurrentLine/unchanged", [&lineEditor]() { DoNotOptimize(lineEditor.GetText()); });
+
+	// Typing and deleting a character keeps the line the same length, but each GetText has to rebuild it
+	harness.Run(
+		"GetCurrentLine/after keystroke",
+		[&lineEditor]()
+		{
+			lineEditor.Insert(U'x');
+			DoNotOptimize(lineEditor.GetText());
+			lineEditor.Backspace();
+		});
+
+	lineEditor.MoveHome();
+	harness.Run(
+		"GetCurrentLine/after keystroke at start",
+		[&lineEditor]()
+		{
+			lineEditor.Insert(U'x');
+			DoNotOptimize(lineEditor.GetText());
+			lineEditor.Backspace();
+		});
+}
@@ -0,0 +1,98 @@
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+#include "Benchmarks.h"
+#include "Harness.h"
+
+namespace
+{
+	constexpr std::string_view usage =
+		"Usage: Microbenchmarks [options]\n"
+		"  --filter TEXT      Runs only the benchmarks with names containing TEXT\n"
+		"  --json FILE        Writes the results to FILE as JSON, keyed by benchmark name\n"
+		"  --samples N        Batches sampled per benchmark; defaults to 30\n"
+		"  --sample-ms N      Milliseconds each sampled batch aims for; defaults to 10\n"
+		"  --warmup-ms N      Milliseconds each benchmark runs before sampling; defaults to 100\n";
+
+	// Parses text that is entirely a number
+	bool ParseNumber(std::string_view text, uint32_t& value)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc{} && end == text.data() + text.size();
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	Harness::Settings settings;
+	std::string_view resultsPath;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view arg = argv[i];
+		if (arg == "--help" || arg == "-h")
+		{
+			std::cout << usage;
+			return 0;
+		}
+
+		if (i + 1 == argc)
+		{
+			std::cerr << "Missing value for " << arg << '\n' << usage;
+			return 2;
+		}
+
+		const std::string_view value = argv[++i];
+		uint32_t number = 0;
+		bool isValid = true;
+		if (arg == "--filter")
+		{
+			settings.filter = value;
+		}
+		else if (arg == "--json")
+		{
+			resultsPath = value;
+		}
+		else if (arg == "--samples")
+		{
+			isValid = ParseNumber(value, settings.samples) && settings.samples > 0;
+		}
+		else if (arg == "--sample-ms")
+		{
+			isValid = ParseNumber(value, number) && number > 0;
+			settings.sampleTime = std::chrono::milliseconds(number);
+		}
+		else if (arg == "--warmup-ms")
+		{
+			isValid = ParseNumber(value, number);
+			settings.warmupTime = std::chrono::milliseconds(number);
+		}
+		else
+		{
+			std::cerr << "Unknown argument " << arg << '\n' << usage;
+			return 2;
+		}
+
+		if (!isValid)
+		{
+			std::cerr << "Invalid value for " << arg << ": " << value << '\n' << usage;
+			return 2;
+		}
+	}
+
+	Harness harness(settings);
+	RunClockBenchmarks(harness);
+	RunVirtualTerminalBenchmarks(harness);
+	RunInputBenchmarks(harness);
+
+	// Last, as presenting takes over the console until the renderer is destroyed
+	RunRendererBenchmarks(harness);
+
+	harness.PrintResults(std::cout);
+	if (!resultsPath.empty() && !harness.WriteResults(resultsPath))
+	{
+		std::cerr << "Failed to write " << resultsPath << '\n';
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,129 @@
+#include "Benchmarks.h"
+
+#include <array>
+#include <format>
+#include <string_view>
+
+#include "NuEngine/ConsoleRenderer.h"
+#include "NuEngine/VirtualTerminalSequences.h"
+
+#include "Harness.h"
+
+using namespace nu::console;
+using namespace std::literals;
+
+namespace
+{
+	struct Size
+	{
+		uint16_t width = 0;
+		uint16_t height = 0;
+	};
+
+	// A small terminal and a large, maximized one
+	constexpr std::array sizes = { Size{ 80, 25 }, Size{ 200, 60 } };
+
+	// Percentages of glyphs that change between presented frames
+	constexpr std::array changePercents = { 0, 10, 50, 100 };
+
+	// Eighty characters, the width of a classic terminal
+	constexpr auto asciiText = "The quick brown fox jumps over the lazy dog while the console keeps redrawing it"sv;
+
+	// Forty code points of one to four bytes each
+	constexpr auto mixedText = u8"Grüße, 世界! ★ café ☕ naïve 🙂 déjà vu 🚀 ok"sv;
+
+	void RunDrawBenchmarks(Harness& harness, ConsoleRenderer& renderer)
+	{
+		const auto width = renderer.GetWidth();
+		const auto height = renderer.GetHeight();
+		const auto sizeName = std::format("{}x{}", width, height);
+
+		harness.Run(
+			std::format("DrawChar/full screen {}", sizeName),
+			[&renderer, width, height]()
+			{
+				for (uint16_t y = 0; y < height; ++y)
+				{
+					for (uint16_t x = 0; x < width; ++x)
+					{
+						DoNotOptimize(renderer.DrawChar(x, y, 'a' + static_cast<char>((x + y) % 26), vt::color::ForegroundBrightGreen));
+					}
+				}
+			});
+
+		harness.Run(
+			std::format("DrawString/80 chars {}", sizeName),
+			[&renderer]() { DoNotOptimize(renderer.DrawString(0, 0, asciiText, vt::color::ForegroundBrightWhite)); });
+
+		harness.Run(
+			std::format("DrawU8String/80 ASCII chars {}", sizeName),
+			[&renderer, text = std::u8string(asciiText.begin(), asciiText.end())]()
+			{
+				DoNotOptimize(renderer.DrawU8String(0, 0, text, vt::color::ForegroundBrightWhite));
+			});
+
+		harness.Run(
+			std::format("DrawU8String/40 mixed UTF-8 chars {}", sizeName),
+			[&renderer]() { DoNotOptimize(renderer.DrawU8String(0, 0, mixedText, vt::color::ForegroundBrightWhite)); });
+
+		harness.Run(std::format("Clear/{}", sizeName), [&renderer]() { renderer.Clear(); });
+	}
+
+	void RunPresentBenchmarks(Harness& harness, ConsoleRenderer& renderer, int changePercent)
+	{
+		const auto width = renderer.GetWidth();
+		const auto height = renderer.GetHeight();
+
+		// Every iteration draws the whole screen, changing the same share of glyphs from the previous frame
+		uint64_t frame = 0;
+		harness.Run(
+			std::format("Present/{}x{} {}% changed", width, height, changePercent),
+			[&renderer, &frame, width, height, changePercent]()
+			{
+				++frame;
+				for (uint16_t y = 0; y < height; ++y)
+				{
+					for (uint16_t x = 0; x < width; ++x)
+					{
+						const size_t i = static_cast<size_t>(y) * width + x;
+						const bool isChanging = static_cast<int>(i % 100) < changePercent;
+						const auto character = 'a' + static_cast<char>((i + (isChanging ? frame : 0)) % 26);
+						renderer.DrawChar(x, y, character, isChanging && frame % 2 == 0 ? vt::color::ForegroundBrightYellow : vt::color::ForegroundWhite);
+					}
+				}
+				renderer.Present();
+			});
+	}
+} // namespace
+
+void RunRendererBenchmarks(Harness& harness)
+{
+	harness.Run(
+		"ReadNextU8Char/ASCII",
+		[text = u8"a"sv]()
+		{
+			auto next = ConsoleRenderer::ReadNextU8Char(text);
+			DoNotOptimize(next);
+		});
+
+	harness.Run(
+		"ReadNextU8Char/4 bytes",
+		[text = u8"🙂"sv]()
+		{
+			auto next = ConsoleRenderer::ReadNextU8Char(text);
+			DoNotOptimize(next);
+		});
+
+	// Presenting writes to the console, so the renderer has the alternate screen buffer until the benchmarks finish
+	ConsoleRenderer renderer;
+	for (const auto& size : sizes)
+	{
+		renderer.Resize(size.width, size.height);
+		RunDrawBenchmarks(harness, renderer);
+
+		for (const auto changePercent : changePercents)
+		{
+			RunPresentBenchmarks(harness, renderer, changePercent);
+		}
+	}
+}
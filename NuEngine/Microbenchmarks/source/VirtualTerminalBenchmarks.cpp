@@ -0,0 +1,67 @@
+#include "Benchmarks.h"
+
+#include <sstream>
+#include <string>
+
+#include "NuEngine/VirtualTerminalSequences.h"
+
+#include "Harness.h"
+
+using namespace nu::console;
+
+void RunVirtualTerminalBenchmarks(Harness& harness)
+{
+	// Vary the arguments, so each iteration formats different numbers
+	uint8_t channel = 0;
+	harness.Run(
+		"ForegroundRGB/string",
+		[&channel]()
+		{
+			++channel;
+			auto sequence = vt::color::ForegroundRGB(channel, 255 - channel, channel / 2);
+			DoNotOptimize(sequence);
+		});
+
+	std::ostringstream stream;
+	harness.Run(
+		"ForegroundRGB/stream",
+		[&channel, &stream]()
+		{
+			++channel;
+			stream.seekp(0);
+			vt::color::ForegroundRGB(channel, 255 - channel, channel / 2, stream);
+			DoNotOptimize(stream);
+		});
+
+	int position = 0;
+	harness.Run(
+		"SetPosition/string",
+		[&position]()
+		{
+			position = (position + 1) % 200;
+			auto sequence = vt::cursor::SetPosition(position + 1, position / 4 + 1);
+			DoNotOptimize(sequence);
+		});
+
+	harness.Run(
+		"SetPosition/stream",
+		[&position, &stream]()
+		{
+			position = (position + 1) % 200;
+			stream.seekp(0);
+			vt::cursor::SetPosition(position + 1, position / 4 + 1, stream);
+			DoNotOptimize(stream);
+		});
+
+	// Appending is what Present does, into a builder that keeps its capacity
+	std::string output;
+	harness.Run(
+		"SetPosition/append",
+		[&position, &output]()
+		{
+			position = (position + 1) % 200;
+			output.clear();
+			vt::cursor::SetPosition(position + 1, position / 4 + 1, output);
+			DoNotOptimize(output);
+		});
+}